@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""
+Generate the PinMap index at the end of variants PeripheralPins.c files.
+
+For each PinMap table, the index gives the position of the first entry of
+each GPIO port and the number of entries of the port, so that a lookup only
+compares the entries of the pin port. Tables must be generated again when a
+table is changed.
+
+Tables containing preprocessor directives, or where the entries of a port
+are not consecutive, are not indexed: they are scanned.
+
+Usage: gen_pinmap_index.py [variant folder...]
+       Default: all folders of variants/
+"""
+import os
+import re
+import sys
+
+BEGIN = "/* ===== PinMap index, generated by CI/utils/gen_pinmap_index.py ===== */"
+END = "/* ===== End of PinMap index ===== */"
+
+table_re = re.compile(r"^\s*(?:WEAK\s+)?const\s+PinMap\s+(PinMap_\w+)\[\]\s*=\s*{")
+entry_re = re.compile(r"^\s*{\s*(\w+)\s*,")
+pin_re = re.compile(r"^P([A-Z])_\d+(_ALT\d+)?$")
+
+
+def parse(lines):
+    """Return list of (table name, guards, [port letter per entry]) to index"""
+    tables = []
+    guards = []
+    i = 0
+    while i < len(lines):
+        line = lines[i].strip()
+        if line.startswith("#if"):
+            guards.append(line)
+        elif line.startswith("#el"):
+            guards[-1] = None  # alternative branch: tables not indexed
+        elif line.startswith("#endif"):
+            guards.pop()
+        m = table_re.match(lines[i])
+        if not m:
+            i += 1
+            continue
+        name = m.group(1)
+        ports = []
+        indexable = None not in guards
+        i += 1
+        while i < len(lines):
+            line = lines[i].strip()
+            if line.startswith("#"):
+                indexable = False
+            elif line.startswith("};"):
+                break
+            else:
+                e = entry_re.match(line)
+                if e:
+                    pin = e.group(1)
+                    if pin == "NC":
+                        pass
+                    else:
+                        p = pin_re.match(pin)
+                        if p:
+                            ports.append(p.group(1))
+                        else:
+                            indexable = False
+            i += 1
+        # Entries of a port must be consecutive
+        seen = []
+        for port in ports:
+            if seen and seen[-1] == port:
+                continue
+            if port in seen:
+                indexable = False
+            seen.append(port)
+        if indexable and ports:
+            tables.append((name, list(guards), ports))
+        i += 1
+    return tables
+
+
+def index_entry(name, ports):
+    first = {}
+    count = {}
+    for pos, port in enumerate(ports):
+        first.setdefault(port, pos)
+        count[port] = count.get(port, 0) + 1
+    letters = sorted(first)
+    first_str = ", ".join("[Port{}] = {}".format(p, first[p]) for p in letters)
+    count_str = ", ".join("[Port{}] = {}".format(p, count[p]) for p in letters)
+    return "  {{{}, {{{}}}, {{{}}}}},\n".format(name, first_str, count_str)
+
+
+def generate(path):
+    with open(path, "r") as f:
+        content = f.read()
+    if BEGIN in content:
+        content = content[: content.index(BEGIN)].rstrip("\n") + "\n"
+    tables = parse(content.splitlines())
+    if not tables:
+        return 0
+
+    out = ["\n", BEGIN + "\n"]
+    out.append("WEAK const PinMapIndex PinMap_Index[] = {\n")
+    for name, guards, ports in tables:
+        for g in guards:
+            out.append(g + "\n")
+        out.append(index_entry(name, ports))
+        for g in guards:
+            out.append("#endif\n")
+    out.append("  {NULL, {0}, {0}}\n")
+    out.append("};\n")
+    out.append(END + "\n")
+    with open(path, "w") as f:
+        f.write(content + "".join(out))
+    return len(tables)
+
+
+def main():
+    script_path = os.path.dirname(os.path.abspath(__file__))
+    variants_path = os.path.join(script_path, "..", "..", "variants")
+    folders = sys.argv[1:]
+    if not folders:
+        folders = sorted(
+            os.path.join(variants_path, d)
+            for d in os.listdir(variants_path)
+            if os.path.isfile(os.path.join(variants_path, d, "PeripheralPins.c"))
+        )
+    for folder in folders:
+        nb = generate(os.path.join(folder, "PeripheralPins.c"))
+        print("{}: {} tables indexed".format(os.path.basename(os.path.normpath(folder)), nb))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,120 @@
+/*
+  Copyright (c) 2020 STMicroelectronics. All right reserved.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _FASTPIN_H_
+#define _FASTPIN_H_
+
+#include "PortNames.h"
+#include "PinNames.h"
+
+#ifdef __cplusplus
+
+/*
+ * \brief GPIO base address of a port, same order as GPIOPort[] but resolved at compile time.
+ */
+constexpr uint32_t fastPinPortBase(uint32_t port)
+{
+  const uint32_t base[] = {
+    GPIOA_BASE,
+    GPIOB_BASE
+#if defined GPIOC_BASE
+    , GPIOC_BASE
+#endif
+#if defined GPIOD_BASE
+    , GPIOD_BASE
+#endif
+#if defined GPIOE_BASE
+    , GPIOE_BASE
+#endif
+#if defined GPIOF_BASE
+    , GPIOF_BASE
+#endif
+#if defined GPIOG_BASE
+    , GPIOG_BASE
+#endif
+#if defined GPIOH_BASE
+    , GPIOH_BASE
+#endif
+#if defined GPIOI_BASE
+    , GPIOI_BASE
+#endif
+#if defined GPIOJ_BASE
+    , GPIOJ_BASE
+#endif
+#if defined GPIOK_BASE
+    , GPIOK_BASE
+#endif
+#if defined GPIOZ_BASE
+    , GPIOZ_BASE
+#endif
+  };
+  return base[port];
+}
+
+/*
+ * \brief GPIO pin resolved at compile time, ex: FastPin<PA_5>::high().
+ * Port address and pin mask are constants: a write is a single BSRR store,
+ * a read a single IDR load. Pin must be configured first with pinMode().
+ */
+template<PinName pin>
+class FastPin {
+    static_assert(STM_VALID_PINNAME(pin), "FastPin: invalid pin name");
+
+  public:
+    static constexpr uint32_t base = fastPinPortBase(STM_PORT(pin));
+    static constexpr uint32_t mask = STM_GPIO_PIN(pin);
+
+    static inline GPIO_TypeDef *port(void)
+    {
+      return (GPIO_TypeDef *)base;
+    }
+
+    static inline void high(void)
+    {
+      port()->BSRR = mask;
+    }
+
+    static inline void low(void)
+    {
+      port()->BSRR = mask << 16;
+    }
+
+    // Branchless: set bit in lower half, or reset bit in upper half
+    static inline void write(uint32_t val)
+    {
+      port()->BSRR = mask << ((val) ? 0 : 16);
+    }
+
+    static inline uint32_t read(void)
+    {
+      return (port()->IDR & mask) ? HIGH : LOW;
+    }
+
+    // Toggle through BSRR: other pins of the port changed by an interrupt are
+    // not overwritten, unlike a read-modify-write of ODR. Not atomic for this
+    // pin: a change of this pin between ODR read and BSRR write is lost.
+    static inline void toggle(void)
+    {
+      uint32_t odr = port()->ODR;
+      port()->BSRR = ((odr & mask) << 16) | (~odr & mask);
+    }
+};
+
+#endif /* __cplusplus */
+
+#endif /* _FASTPIN_H_ */
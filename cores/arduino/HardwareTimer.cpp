@@ -65,6 +65,17 @@ HardwareTimer::HardwareTimer(TIM_TypeDef *instance)
   _timerObj.handle.State = HAL_TIM_STATE_RESET;
 
   _timerObj.__this = (void *)this;
+  _hdma = NULL;
+  _dmaSource = 0;
+  _dmaLength = 0;
+  _dmaDefaultRoute = false;
+  _encoderMode = false;
+  _encoderIndexChannel = 0;
+  _encoderSampleChannel = 0;
+  _encoderCounter = 0;
+  _encoderBase = 0;
+  _encoderOffset = 0;
+  _onePulseChannel = 0;
   _timerObj.preemptPriority = TIM_IRQ_PRIO;
   _timerObj.subPriority = TIM_IRQ_SUBPRIO;
 
@@ -75,12 +86,15 @@ HardwareTimer::HardwareTimer(TIM_TypeDef *instance)
   // Initialize NULL callbacks
   for (int i = 0; i < TIMER_CHANNELS + 1 ; i++) {
     callbacks[i] = NULL;
+    argCallbacks[i] = NULL;
+    callbackArgs[i] = NULL;
   }
 
   // Initialize channel mode and complementary
   for (int i = 0; i < TIMER_CHANNELS; i++) {
 #if defined(TIM_CCER_CC1NE)
     isComplementaryChannel[i] = false;
+    isComplementaryPair[i] = false;
 #endif
     _ChannelMode[i] = TIMER_DISABLED;
   }
@@ -154,8 +168,8 @@ void HardwareTimer::pauseChannel(uint32_t channel)
   */
 void HardwareTimer::resume(void)
 {
-  // Clear flag and ennable IT
-  if (callbacks[0] != NULL) {
+  // Clear flag and ennable IT. Encoder needs update IT to track rollovers
+  if (isCallbackAttached(0) || _encoderMode) {
     __HAL_TIM_CLEAR_FLAG(&(_timerObj.handle), TIM_FLAG_UPDATE);
     __HAL_TIM_ENABLE_IT(&(_timerObj.handle), TIM_IT_UPDATE);
 
@@ -247,6 +261,12 @@ int HardwareTimer::getLLChannel(uint32_t channel)
       default:
         return_value = -1;
     }
+#if defined(TIM_CCER_CC1NE)
+    if (isComplementaryPair[channel - 1] && (return_value != (uint32_t) -1)) {
+      // Both outputs: CHxN enable bit is next to CHx one
+      return_value |= (return_value << 2);
+    }
+#endif
   }
   return return_value;
 }
@@ -331,7 +351,7 @@ void HardwareTimer::resumeChannel(uint32_t channel)
   }
 
   // Clear flag and enable IT
-  if (callbacks[channel] != NULL) {
+  if (isCallbackAttached(channel) || (channel == _encoderIndexChannel) || (channel == _encoderSampleChannel)) {
     __HAL_TIM_CLEAR_FLAG(&(_timerObj.handle), interrupt);
     __HAL_TIM_ENABLE_IT(&(_timerObj.handle), interrupt);
   }
@@ -340,7 +360,10 @@ void HardwareTimer::resumeChannel(uint32_t channel)
     case TIMER_OUTPUT_COMPARE_PWM1:
     case TIMER_OUTPUT_COMPARE_PWM2: {
 #if defined(TIM_CCER_CC1NE)
-        if (isComplementaryChannel[channel - 1]) {
+        if (isComplementaryPair[channel - 1]) {
+          HAL_TIM_PWM_Start(&(_timerObj.handle), timChannel);
+          HAL_TIMEx_PWMN_Start(&(_timerObj.handle), timChannel);
+        } else if (isComplementaryChannel[channel - 1]) {
           HAL_TIMEx_PWMN_Start(&(_timerObj.handle), timChannel);
         } else
 #endif
@@ -356,7 +379,10 @@ void HardwareTimer::resumeChannel(uint32_t channel)
     case TIMER_OUTPUT_COMPARE_FORCED_ACTIVE:
     case TIMER_OUTPUT_COMPARE_FORCED_INACTIVE: {
 #if defined(TIM_CCER_CC1NE)
-        if (isComplementaryChannel[channel - 1]) {
+        if (isComplementaryPair[channel - 1]) {
+          HAL_TIM_OC_Start(&(_timerObj.handle), timChannel);
+          HAL_TIMEx_OCN_Start(&(_timerObj.handle), timChannel);
+        } else if (isComplementaryChannel[channel - 1]) {
           HAL_TIMEx_OCN_Start(&(_timerObj.handle), timChannel);
         } else
 #endif
@@ -371,7 +397,7 @@ void HardwareTimer::resumeChannel(uint32_t channel)
         // Enable 2nd associated channel
         timAssociatedInputChannel = getAssociatedChannel(channel);
         LL_TIM_CC_EnableChannel(_timerObj.handle.Instance, getLLChannel(timAssociatedInputChannel));
-        if (callbacks[channel] != NULL) {
+        if (isCallbackAttached(channel)) {
           __HAL_TIM_CLEAR_FLAG(&(_timerObj.handle), getIT(timAssociatedInputChannel));
           __HAL_TIM_ENABLE_IT(&(_timerObj.handle), getIT(timAssociatedInputChannel));
         }
@@ -379,7 +405,10 @@ void HardwareTimer::resumeChannel(uint32_t channel)
       break;
     case TIMER_INPUT_CAPTURE_RISING:
     case TIMER_INPUT_CAPTURE_FALLING:
-    case TIMER_INPUT_CAPTURE_BOTHEDGE: {
+    case TIMER_INPUT_CAPTURE_BOTHEDGE:
+    case TIMER_ENCODER_TI1:
+    case TIMER_ENCODER_TI2:
+    case TIMER_ENCODER_TI12: {
         HAL_TIM_IC_Start(&(_timerObj.handle), timChannel);
       }
       break;
@@ -424,13 +453,16 @@ uint32_t HardwareTimer::getOverflow(TimerFormat_t format)
   // Hardware register correspond to period count-1. Example ARR register value 9 means period of 10 timer cycle
   uint32_t ARR_RegisterValue = LL_TIM_GetAutoReload(_timerObj.handle.Instance);
   uint32_t Prescalerfactor = LL_TIM_GetPrescaler(_timerObj.handle.Instance) + 1;
+  // In center-aligned modes, period is counting up to ARR and down to 0
+  uint32_t period_cyc = (READ_BIT(_timerObj.handle.Instance->CR1, TIM_CR1_CMS) != 0) ?
+                        (2 * ARR_RegisterValue * Prescalerfactor) : ((ARR_RegisterValue + 1) * Prescalerfactor);
   uint32_t return_value;
   switch (format) {
     case MICROSEC_FORMAT:
-      return_value = (uint32_t)(((ARR_RegisterValue + 1) * Prescalerfactor * 1000000.0) / getTimerClkFreq());
+      return_value = (uint32_t)((period_cyc * 1000000.0) / getTimerClkFreq());
       break;
     case HERTZ_FORMAT:
-      return_value = (uint32_t)(getTimerClkFreq() / ((ARR_RegisterValue + 1) * Prescalerfactor));
+      return_value = (uint32_t)(getTimerClkFreq() / period_cyc);
       break;
     case TICK_FORMAT:
     default :
@@ -454,19 +486,27 @@ void HardwareTimer::setOverflow(uint32_t overflow, TimerFormat_t format)
   uint32_t ARR_RegisterValue;
   uint32_t Prescalerfactor;
   uint32_t period_cyc;
+  // In center-aligned modes, counter counts up to ARR then down to 0: period is 2 * ARR
+  bool centerAligned = (READ_BIT(_timerObj.handle.Instance->CR1, TIM_CR1_CMS) != 0);
   // Remark: Hardware register correspond to period count-1. Example ARR register value 9 means period of 10 timer cycle
   switch (format) {
     case MICROSEC_FORMAT:
       period_cyc = overflow * (getTimerClkFreq() / 1000000);
+      if (centerAligned) {
+        period_cyc /= 2;
+      }
       Prescalerfactor = (period_cyc / 0x10000) + 1;
       LL_TIM_SetPrescaler(_timerObj.handle.Instance, Prescalerfactor - 1);
-      ARR_RegisterValue = (period_cyc / Prescalerfactor) - 1;
+      ARR_RegisterValue = (period_cyc / Prescalerfactor) - (centerAligned ? 0 : 1);
       break;
     case HERTZ_FORMAT:
       period_cyc = getTimerClkFreq() / overflow;
+      if (centerAligned) {
+        period_cyc /= 2;
+      }
       Prescalerfactor = (period_cyc / 0x10000) + 1;
       LL_TIM_SetPrescaler(_timerObj.handle.Instance, Prescalerfactor - 1);
-      ARR_RegisterValue = (period_cyc / Prescalerfactor) - 1;
+      ARR_RegisterValue = (period_cyc / Prescalerfactor) - (centerAligned ? 0 : 1);
       break;
     case TICK_FORMAT:
     default :
@@ -566,6 +606,18 @@ void HardwareTimer::setMode(uint32_t channel, TimerModes_t mode, PinName pin)
   // Save channel selected mode to object attribute
   _ChannelMode[channel - 1] = mode;
 
+  if (_encoderMode && (channel <= 2) &&
+      (mode != TIMER_ENCODER_TI1) && (mode != TIMER_ENCODER_TI2) && (mode != TIMER_ENCODER_TI12)) {
+    // Leave encoder interface
+    LL_TIM_SetSlaveMode(_timerObj.handle.Instance, LL_TIM_SLAVEMODE_DISABLED);
+    _encoderMode = false;
+    _encoderSampleChannel = 0;
+  }
+  if ((channel == _encoderSampleChannel) && (mode != TIMER_OUTPUT_COMPARE)) {
+    // Channel taken back by user: encoder position only sampled on rollover
+    _encoderSampleChannel = 0;
+  }
+
   /* Configure some default values. Maybe overwritten later */
   channelOC.OCMode = TIMER_NOT_USED;
   channelOC.Pulse = __HAL_TIM_GET_COMPARE(&(_timerObj.handle), timChannel);  // keep same value already written in hardware <register
@@ -649,6 +701,33 @@ void HardwareTimer::setMode(uint32_t channel, TimerModes_t mode, PinName pin)
       channelIC.ICSelection = TIM_ICSELECTION_INDIRECTTI;
       HAL_TIM_IC_ConfigChannel(&(_timerObj.handle), &channelIC, getChannel(timAssociatedInputChannel));
       break;
+    case TIMER_ENCODER_TI1:
+    case TIMER_ENCODER_TI2:
+    case TIMER_ENCODER_TI12:
+      if ((channel > 2) || !IS_TIM_ENCODER_INTERFACE_INSTANCE(_timerObj.handle.Instance)) {
+        Error_Handler();
+      }
+      // Encoder interface uses both channel 1 and channel 2 inputs
+      _ChannelMode[0] = mode;
+      _ChannelMode[1] = mode;
+      channelIC.ICPolarity = TIM_INPUTCHANNELPOLARITY_RISING;
+      channelIC.ICSelection = TIM_ICSELECTION_DIRECTTI;
+      HAL_TIM_IC_ConfigChannel(&(_timerObj.handle), &channelIC, TIM_CHANNEL_1);
+      HAL_TIM_IC_ConfigChannel(&(_timerObj.handle), &channelIC, TIM_CHANNEL_2);
+      LL_TIM_SetEncoderMode(_timerObj.handle.Instance, (mode == TIMER_ENCODER_TI1) ? LL_TIM_ENCODERMODE_X2_TI1 :
+                            (mode == TIMER_ENCODER_TI2) ? LL_TIM_ENCODERMODE_X2_TI2 : LL_TIM_ENCODERMODE_X4_TI12);
+      if (!_encoderMode) {
+        // Position 0 at current counter value. A free channel samples the
+        // counter half a period away from the last sample.
+        _encoderMode = true;
+        _encoderCounter = LL_TIM_GetCounter(_timerObj.handle.Instance) & 0xFFFF;
+        _encoderBase = 0;
+        _encoderOffset = 0;
+        if (IS_TIM_CC4_INSTANCE(_timerObj.handle.Instance)) {
+          setEncoderSampleChannel((_encoderIndexChannel == 4) ? 3 : 4);
+        }
+      }
+      break;
     default:
       break;
   }
@@ -657,7 +736,8 @@ void HardwareTimer::setMode(uint32_t channel, TimerModes_t mode, PinName pin)
     if ((int)get_pwm_channel(pin) == timChannel) {
 #if defined(STM32F1xx)
       if ((mode == TIMER_INPUT_CAPTURE_RISING) || (mode == TIMER_INPUT_CAPTURE_FALLING) \
-          || (mode == TIMER_INPUT_CAPTURE_BOTHEDGE) || (mode == TIMER_INPUT_FREQ_DUTY_MEASUREMENT)) {
+          || (mode == TIMER_INPUT_CAPTURE_BOTHEDGE) || (mode == TIMER_INPUT_FREQ_DUTY_MEASUREMENT) \
+          || (mode == TIMER_ENCODER_TI1) || (mode == TIMER_ENCODER_TI2) || (mode == TIMER_ENCODER_TI12)) {
         // on F1 family, input alternate function must configure GPIO in input mode
         pinMode(pin, INPUT);
       } else
@@ -673,10 +753,50 @@ void HardwareTimer::setMode(uint32_t channel, TimerModes_t mode, PinName pin)
 
 #if defined(TIM_CCER_CC1NE)
     isComplementaryChannel[channel - 1] = STM_PIN_INVERTED(pinmap_function(pin, PinMap_PWM));
+    isComplementaryPair[channel - 1] = false;
 #endif
   }
 }
 
+#if defined(TIM_CCER_CC1NE)
+/**
+  * @brief  Set channel mode with both regular and complementary outputs
+  * @param  channel: Arduino channel [1..4]
+  * @param  mode: mode configuration for the channel (see TimerModes_t)
+  * @param  pin: Arduino pin number of CHx output, ex: D1, 1 or PA1
+  * @param  pinN: Arduino pin number of CHxN output
+  * @retval None
+  */
+void HardwareTimer::setMode(uint32_t channel, TimerModes_t mode, uint32_t pin, uint32_t pinN)
+{
+  setMode(channel, mode, digitalPinToPinName(pin), digitalPinToPinName(pinN));
+}
+
+/**
+  * @brief  Set channel mode with both regular and complementary outputs
+  * @param  channel: Arduino channel [1..4]
+  * @param  mode: mode configuration for the channel (see TimerModes_t)
+  * @param  pin: pin name of CHx output, ex: PA_8
+  * @param  pinN: pin name of CHxN output, ex: PB_13
+  * @retval None
+  */
+void HardwareTimer::setMode(uint32_t channel, TimerModes_t mode, PinName pin, PinName pinN)
+{
+  setMode(channel, mode, pin);
+
+  if ((pin != NC) && (pinN != NC)) {
+    if (((int)get_pwm_channel(pinN) != getChannel(channel)) || isComplementaryChannel[channel - 1] ||
+        !STM_PIN_INVERTED(pinmap_function(pinN, PinMap_PWM)) ||
+        (pinmap_peripheral(pinN, PinMap_PWM) != (void *)_timerObj.handle.Instance)) {
+      // pin must be CHx and pinN must be CHxN of this timer
+      Error_Handler();
+    }
+    pinmap_pinout(pinN, PinMap_PWM);
+    isComplementaryPair[channel - 1] = true;
+  }
+}
+#endif
+
 /**
   * @brief  Set channel Capture/Compare register
   * @param  channel: Arduino channel [1..4]
@@ -734,6 +854,242 @@ void HardwareTimer::setCaptureCompare(uint32_t channel, uint32_t compare, TimerC
   __HAL_TIM_SET_COMPARE(&(_timerObj.handle), timChannel, CCR_RegisterValue);
 }
 
+/**
+  * @brief  Extend a 16-bit encoder counter value to 32-bit
+  * @note   Must be called with interrupts disabled, or from timer interrupt.
+  *         Counter is sampled on rollover (update event) and when it reaches
+  *         last sample value + 0x8000 (compare event of sample channel).
+  *         Starting from last sample, a rollover is reached downward from the
+  *         lower half and upward from the upper half, the compare value the
+  *         other way: direction of an event is known, and without event the
+  *         counter is less than half a period away from last sample.
+  * @param  counter: current counter value
+  * @param  rollover: update event occurred since last sample
+  * @param  midRange: compare event of sample channel occurred since last sample
+  * @retval 32-bit position, not including offset
+  */
+int32_t HardwareTimer::getEncoderRawCount(uint32_t counter, bool rollover, bool midRange)
+{
+  uint32_t from = _encoderCounter;
+  int32_t position = _encoderBase;
+
+  if (midRange) {
+    position += (from < 0x8000) ? 0x8000 : -0x8000;
+    from ^= 0x8000;
+  }
+  if (rollover) {
+    position += (from < 0x8000) ? -(int32_t)from : 0x10000 - (int32_t)from;
+    from = 0;
+  }
+  return position + (int16_t)(counter - from);
+}
+
+/**
+  * @brief  Current 32-bit encoder position, including events not yet handled
+  *         by timer interrupt
+  * @note   Must be called with interrupts disabled, or from timer interrupt.
+  * @retval 32-bit position, not including offset
+  */
+int32_t HardwareTimer::getEncoderPosition(void)
+{
+  TIM_TypeDef *tim = _timerObj.handle.Instance;
+  // Counter is read first: an event occurring after it is still seen in
+  // status register, and counter is then counted from the event position.
+  uint32_t counter = LL_TIM_GetCounter(tim);
+  bool rollover = (LL_TIM_IsActiveFlag_UPDATE(tim) != 0);
+  bool midRange = (_encoderSampleChannel != 0) && ((tim->SR & (TIM_FLAG_CC1 << (_encoderSampleChannel - 1))) != 0);
+  int32_t position = getEncoderRawCount(counter, rollover, midRange);
+
+  if ((_encoderSampleChannel == 0) && !rollover) {
+    // No sample channel: each read is a sample, position is exact as long
+    // as counter moves less than half a period between two samples
+    _encoderBase = position;
+    _encoderCounter = counter & 0xFFFF;
+  }
+  return position;
+}
+
+/**
+  * @brief  Take an encoder sample, called by timer interrupt
+  * @param  rollover: update event occurred since last sample
+  * @param  midRange: compare event of sample channel occurred since last sample
+  * @retval None
+  */
+void HardwareTimer::encoderSample(bool rollover, bool midRange)
+{
+  TIM_TypeDef *tim = _timerObj.handle.Instance;
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  uint32_t counter = LL_TIM_GetCounter(tim) & 0xFFFF;
+  _encoderBase = getEncoderRawCount(counter, rollover, midRange);
+  _encoderCounter = counter;
+  if (_encoderSampleChannel != 0) {
+    // Next compare event half a period away. Flag is cleared after the new
+    // value is set: a match of the previous value must not be taken for it.
+    __HAL_TIM_SET_COMPARE(&(_timerObj.handle), getChannel(_encoderSampleChannel), counter ^ 0x8000);
+    __HAL_TIM_CLEAR_FLAG(&(_timerObj.handle), TIM_FLAG_CC1 << (_encoderSampleChannel - 1));
+  }
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Select the output compare channel sampling encoder counter
+  * @param  channel: Arduino channel [3..4], 0 if none
+  * @retval None
+  */
+void HardwareTimer::setEncoderSampleChannel(uint32_t channel)
+{
+  _encoderSampleChannel = channel;
+  if (channel != 0) {
+    setMode(channel, TIMER_OUTPUT_COMPARE);
+    __HAL_TIM_SET_COMPARE(&(_timerObj.handle), getChannel(channel), _encoderCounter ^ 0x8000);
+  }
+}
+
+/**
+  * @brief  Retrieve encoder position
+  * @note   Timer must be configured with TIMER_ENCODER_xxx mode, auto-reload
+  *         register must be kept to its default value (0xFFFF). Timers with
+  *         only 2 channels have no sample channel: getEncoderCount() must
+  *         then be called at least every half period (32768 edges).
+  * @retval 32-bit encoder position
+  */
+int32_t HardwareTimer::getEncoderCount(void)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  int32_t count = getEncoderPosition() - _encoderOffset;
+  __set_PRIMASK(primask);
+  return count;
+}
+
+/**
+  * @brief  Set encoder position
+  * @param  count: new 32-bit encoder position
+  * @retval None
+  */
+void HardwareTimer::setEncoderCount(int32_t count)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  _encoderOffset = getEncoderPosition() - count;
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Reset encoder position upon index pulse
+  * @note   If pin is connected to channel 3 or 4 of this timer, the position is
+  *         captured by hardware. Otherwise an external interrupt is used and
+  *         position may be off by the edges counted during interrupt latency.
+  *         Must be called before resume().
+  * @param  pin: index pin
+  * @param  mode: RISING, FALLING or CHANGE
+  * @retval None
+  */
+void HardwareTimer::setEncoderIndex(PinName pin, uint32_t mode)
+{
+  uint32_t function = pinmap_function(pin, PinMap_PWM);
+
+  if ((pinmap_peripheral(pin, PinMap_PWM) == _timerObj.handle.Instance) &&
+      (STM_PIN_CHANNEL(function) > 2) && !STM_PIN_INVERTED(function)) {
+    _encoderIndexChannel = STM_PIN_CHANNEL(function);
+    if (_encoderIndexChannel == _encoderSampleChannel) {
+      // Sample channel moves to the other one
+      setEncoderSampleChannel(7 - _encoderIndexChannel);
+    }
+    setMode(_encoderIndexChannel, (mode == RISING) ? TIMER_INPUT_CAPTURE_RISING :
+            (mode == FALLING) ? TIMER_INPUT_CAPTURE_FALLING : TIMER_INPUT_CAPTURE_BOTHEDGE, pin);
+  } else {
+    ::attachInterrupt(pinNametoDigitalPin(pin), [this]() {
+      setEncoderCount(0);
+    }, mode);
+  }
+}
+
+void HardwareTimer::setEncoderIndex(uint32_t pin, uint32_t mode)
+{
+  setEncoderIndex(digitalPinToPinName(pin), mode);
+}
+
+void HardwareTimer::setEncoderIndex(PinName pin)
+{
+  setEncoderIndex(pin, RISING);
+}
+
+void HardwareTimer::setEncoderIndex(uint32_t pin)
+{
+  setEncoderIndex(pin, RISING);
+}
+
+/**
+  * @brief  Select the event sent on trigger output (TRGO), to synchronize
+  *         other timers (or trigger ADC/DAC)
+  * @param  trigger: TIM_TRGO_xxx ex: TIM_TRGO_RESET, TIM_TRGO_ENABLE, TIM_TRGO_UPDATE, TIM_TRGO_OC1REF
+  * @param  masterSlaveMode: delay effect of trigger input of this timer, to
+  *         be exactly synchronized with its slaves when this timer is also a slave
+  * @retval true if timer is a master, false otherwise
+  */
+bool HardwareTimer::setTriggerOutput(uint32_t trigger, bool masterSlaveMode)
+{
+  TIM_MasterConfigTypeDef sMasterConfig = {};
+
+  if (!IS_TIM_MASTER_INSTANCE(_timerObj.handle.Instance)) {
+    return false;
+  }
+  sMasterConfig.MasterOutputTrigger = trigger;
+#if defined(TIM_TRGO2_RESET)
+  sMasterConfig.MasterOutputTrigger2 = TIM_TRGO2_RESET;
+#endif
+  sMasterConfig.MasterSlaveMode = (masterSlaveMode) ? TIM_MASTERSLAVEMODE_ENABLE : TIM_MASTERSLAVEMODE_DISABLE;
+  return HAL_TIMEx_MasterConfigSynchronization(&(_timerObj.handle), &sMasterConfig) == HAL_OK;
+}
+
+/**
+  * @brief  Configure timer as slave of a trigger input
+  * @note   Slave mode replaces encoder mode. In TIMER_SLAVE_EXTERNAL_CLOCK mode, prescaler
+  *         and overflow apply to trigger edges: with master TRGO set to TIM_TRGO_UPDATE,
+  *         both timers make a cascaded counter.
+  * @param  mode: slave mode
+  * @param  trigger: TIM_TS_ITRx for the TRGO of another timer, see "TIMx internal trigger
+  *         connection" table of the reference manual. Or TIM_TS_TI1FP1, TIM_TS_TI2FP2...
+  * @retval true if timer is a slave, false otherwise
+  */
+bool HardwareTimer::setSlaveMode(TimerSlaveModes_t mode, uint32_t trigger)
+{
+  TIM_SlaveConfigTypeDef sSlaveConfig = {};
+
+  if (!IS_TIM_SLAVE_INSTANCE(_timerObj.handle.Instance)) {
+    return false;
+  }
+  _encoderMode = false;
+  _encoderSampleChannel = 0;
+  if (mode == TIMER_SLAVE_DISABLED) {
+    LL_TIM_SetSlaveMode(_timerObj.handle.Instance, LL_TIM_SLAVEMODE_DISABLED);
+    return true;
+  }
+
+  switch (mode) {
+    case TIMER_SLAVE_RESET:
+      sSlaveConfig.SlaveMode = TIM_SLAVEMODE_RESET;
+      break;
+    case TIMER_SLAVE_GATED:
+      sSlaveConfig.SlaveMode = TIM_SLAVEMODE_GATED;
+      break;
+    case TIMER_SLAVE_TRIGGER:
+      sSlaveConfig.SlaveMode = TIM_SLAVEMODE_TRIGGER;
+      break;
+    case TIMER_SLAVE_EXTERNAL_CLOCK:
+    default:
+      sSlaveConfig.SlaveMode = TIM_SLAVEMODE_EXTERNAL1;
+      break;
+  }
+  sSlaveConfig.InputTrigger = trigger;
+  sSlaveConfig.TriggerPolarity = TIM_TRIGGERPOLARITY_NONINVERTED;
+  sSlaveConfig.TriggerPrescaler = TIM_TRIGGERPRESCALER_DIV1;
+  sSlaveConfig.TriggerFilter = 0;
+  return HAL_TIM_SlaveConfigSynchro(&(_timerObj.handle), &sSlaveConfig) == HAL_OK;
+}
+
 /**
   * @brief  Retrieve Capture/Compare value
   * @param  channel: Arduino channel [1..4]
@@ -832,6 +1188,326 @@ void HardwareTimer::setPWM(uint32_t channel, PinName pin, uint32_t frequency, ui
   resume();
 }
 
+/**
+  * @brief  Configure one pulse generation on a pin
+  * @param  channel: Arduino channel [1..4]
+  * @param  pin: Arduino pin number, ex: D1, 1 or PA1
+  * @param  delay: delay between start and pulse, in nanoseconds
+  * @param  width: pulse width, in nanoseconds
+  * @retval None
+  */
+void HardwareTimer::setOnePulse(uint32_t channel, uint32_t pin, uint32_t delay, uint32_t width)
+{
+  setOnePulse(channel, digitalPinToPinName(pin), delay, width);
+}
+
+/**
+  * @brief  Configure one pulse generation on a pin. Pulse is produced by hardware
+  *         once started by startPulse() or by trigger input (see setPulseTrigger()),
+  *         then counter stops. Delay and width are rounded to timer resolution, which
+  *         depends on prescaler required by their sum.
+  * @param  channel: Arduino channel [1..4]
+  * @param  pin: pin name, ex: PB_0
+  * @param  delay: delay between start and pulse, in nanoseconds (at least 1 tick)
+  * @param  width: pulse width, in nanoseconds (at least 1 tick)
+  * @retval None
+  */
+void HardwareTimer::setOnePulse(uint32_t channel, PinName pin, uint32_t delay, uint32_t width)
+{
+  TIM_TypeDef *tim = _timerObj.handle.Instance;
+  uint32_t delay_cyc = (uint32_t)((((uint64_t)delay * getTimerClkFreq()) + 500000000U) / 1000000000U);
+  uint32_t width_cyc = (uint32_t)((((uint64_t)width * getTimerClkFreq()) + 500000000U) / 1000000000U);
+  uint32_t Prescalerfactor = ((delay_cyc + width_cyc) / (MAX_RELOAD + 1)) + 1;
+  uint32_t CCR_RegisterValue = delay_cyc / Prescalerfactor;
+  uint32_t width_tick = width_cyc / Prescalerfactor;
+
+  if (Prescalerfactor > (MAX_RELOAD + 1)) {
+    Prescalerfactor = MAX_RELOAD + 1;
+  }
+  // Output is inactive while counter is stopped at 0
+  if (CCR_RegisterValue == 0) {
+    CCR_RegisterValue = 1;
+  }
+  if (width_tick == 0) {
+    width_tick = 1;
+  }
+
+  LL_TIM_DisableCounter(tim);
+  // PWM2: output is active from compare value up to auto-reload value
+  setMode(channel, TIMER_OUTPUT_COMPARE_PWM2, pin);
+  LL_TIM_SetPrescaler(tim, Prescalerfactor - 1);
+  __HAL_TIM_SET_AUTORELOAD(&(_timerObj.handle), min(CCR_RegisterValue + width_tick - 1, (uint32_t)MAX_RELOAD));
+  __HAL_TIM_SET_COMPARE(&(_timerObj.handle), getChannel(channel), CCR_RegisterValue);
+  LL_TIM_SetOnePulseMode(tim, LL_TIM_ONEPULSEMODE_SINGLE);
+
+  // Load preloaded registers without update interrupt, counter is not started
+  uint32_t updateSource = LL_TIM_GetUpdateSource(tim);
+  LL_TIM_SetUpdateSource(tim, LL_TIM_UPDATESOURCE_COUNTER);
+  LL_TIM_GenerateEvent_UPDATE(tim);
+  LL_TIM_SetUpdateSource(tim, updateSource);
+
+  // Enable output only
+  LL_TIM_CC_EnableChannel(tim, getLLChannel(channel));
+#if defined(TIM_BDTR_MOE)
+  if (IS_TIM_BREAK_INSTANCE(tim)) {
+    __HAL_TIM_MOE_ENABLE(&(_timerObj.handle));
+  }
+#endif
+  _onePulseChannel = channel;
+}
+
+/**
+  * @brief  Start pulse upon trigger input
+  * @param  trigger: trigger input, TIM_TS_ITRx (TRGO of another timer, see reference manual),
+  *         TIM_TS_TI1FP1 or TIM_TS_TI2FP2 (channel configured as input capture on the trigger pin)...
+  * @param  retriggerable: a trigger during delay or pulse restarts it.
+  *         Only on timers supporting retriggerable one pulse mode.
+  * @retval false if timer has no trigger input, retriggerable mode is not supported
+  *         or setOnePulse() hasn't been called
+  */
+bool HardwareTimer::setPulseTrigger(uint32_t trigger, bool retriggerable)
+{
+  TIM_SlaveConfigTypeDef sSlaveConfig = {};
+  // LL channel of regular output, compare mode is the same for complementary output
+  uint32_t LLChannel = LL_TIM_CHANNEL_CH1 << (4 * (_onePulseChannel - 1));
+
+  if ((_onePulseChannel == 0) || !IS_TIM_SLAVE_INSTANCE(_timerObj.handle.Instance)) {
+    return false;
+  }
+
+  if (retriggerable) {
+#if defined(TIM_SLAVEMODE_COMBINED_RESETTRIGGER) && defined(LL_TIM_OCMODE_RETRIG_OPM2)
+    // Inactive until trigger, then compared as PWM2 and inactive again upon update
+    LL_TIM_OC_SetMode(_timerObj.handle.Instance, LLChannel, LL_TIM_OCMODE_RETRIG_OPM2);
+    sSlaveConfig.SlaveMode = TIM_SLAVEMODE_COMBINED_RESETTRIGGER;
+#else
+    return false;
+#endif
+  } else {
+    LL_TIM_OC_SetMode(_timerObj.handle.Instance, LLChannel, LL_TIM_OCMODE_PWM2);
+    sSlaveConfig.SlaveMode = TIM_SLAVEMODE_TRIGGER;
+  }
+  _encoderMode = false;
+  _encoderSampleChannel = 0;
+  sSlaveConfig.InputTrigger = trigger;
+  sSlaveConfig.TriggerPolarity = TIM_TRIGGERPOLARITY_NONINVERTED;
+  sSlaveConfig.TriggerPrescaler = TIM_TRIGGERPRESCALER_DIV1;
+  sSlaveConfig.TriggerFilter = 0;
+  return HAL_TIM_SlaveConfigSynchro(&(_timerObj.handle), &sSlaveConfig) == HAL_OK;
+}
+
+/**
+  * @brief  Start pulse by software. Ignored while a pulse is running.
+  * @retval None
+  */
+void HardwareTimer::startPulse(void)
+{
+  LL_TIM_EnableCounter(_timerObj.handle.Instance);
+}
+
+/**
+  * @brief  Check whether a pulse (delay or active level) is running
+  * @retval true until counter stops at the end of pulse
+  */
+bool HardwareTimer::isPulseRunning(void)
+{
+  return LL_TIM_IsEnabledCounter(_timerObj.handle.Instance);
+}
+
+/**
+  * @brief  Select counting direction: edge-aligned up or down, or center-aligned
+  * @note   Counter must be disabled (before resume() or after pause()) to switch
+  *         between edge-aligned and center-aligned modes
+  * @param  mode: counter mode (see TimerCounterModes_t)
+  * @retval None
+  */
+void HardwareTimer::setCounterMode(TimerCounterModes_t mode)
+{
+  uint32_t counterMode;
+
+  switch (mode) {
+    case TIMER_COUNTER_DOWN:
+      counterMode = TIM_COUNTERMODE_DOWN;
+      break;
+    case TIMER_COUNTER_CENTER_DOWN:
+      counterMode = TIM_COUNTERMODE_CENTERALIGNED1;
+      break;
+    case TIMER_COUNTER_CENTER_UP:
+      counterMode = TIM_COUNTERMODE_CENTERALIGNED2;
+      break;
+    case TIMER_COUNTER_CENTER_UP_DOWN:
+      counterMode = TIM_COUNTERMODE_CENTERALIGNED3;
+      break;
+    case TIMER_COUNTER_UP:
+    default:
+      counterMode = TIM_COUNTERMODE_UP;
+      break;
+  }
+
+  if ((counterMode != TIM_COUNTERMODE_UP) && !IS_TIM_COUNTER_MODE_SELECT_INSTANCE(_timerObj.handle.Instance)) {
+    // Basic and some general purpose timers only count up
+    Error_Handler();
+  }
+  _timerObj.handle.Init.CounterMode = counterMode;
+  LL_TIM_SetCounterMode(_timerObj.handle.Instance, counterMode);
+}
+
+#if defined(TIM_CCER_CC1NE)
+/**
+  * @brief  Configure dead-time inserted between complementary outputs
+  * @note   Dead-time generator is clocked by timer clock divided by clock division,
+  *         which is increased when dead-time doesn't fit with lower division.
+  *         Clock division is also used to sample inputs when filters are enabled.
+  * @param  nanoseconds: dead-time duration, rounded up to dead-time generator resolution
+  * @retval false if timer has no dead-time generator or dead-time is too long
+  */
+bool HardwareTimer::setDeadTime(uint32_t nanoseconds)
+{
+  const uint32_t clockDivisions[] = {TIM_CLOCKDIVISION_DIV1, TIM_CLOCKDIVISION_DIV2, TIM_CLOCKDIVISION_DIV4};
+
+  if (!IS_TIM_BREAK_INSTANCE(_timerObj.handle.Instance)) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < 3; i++) {
+    uint32_t ticks = (uint32_t)((((uint64_t)nanoseconds * (getTimerClkFreq() >> i)) + 999999999U) / 1000000000U);
+    uint32_t DTG_RegisterValue;
+
+    // DTG[7:5] selects dead-time step: 1, 2, 8 or 16 ticks
+    if (ticks <= 127) {
+      DTG_RegisterValue = ticks;
+    } else if (ticks <= 254) {
+      DTG_RegisterValue = 0x80 | (((ticks + 1) / 2) - 64);
+    } else if (ticks <= 504) {
+      DTG_RegisterValue = 0xC0 | (((ticks + 7) / 8) - 32);
+    } else if (ticks <= 1008) {
+      DTG_RegisterValue = 0xE0 | (((ticks + 15) / 16) - 32);
+    } else {
+      continue;
+    }
+    _timerObj.handle.Init.ClockDivision = clockDivisions[i];
+    LL_TIM_SetClockDivision(_timerObj.handle.Instance, clockDivisions[i]);
+    LL_TIM_OC_SetDeadTime(_timerObj.handle.Instance, DTG_RegisterValue);
+    return true;
+  }
+  return false;
+}
+
+/**
+  * @brief  Configure break input: when active, all outputs are disabled (set to their idle state)
+  * @note   Break input pin must be configured in its alternate function by user
+  * @param  enable: enable or disable break input
+  * @param  polarity: active level of break input, HIGH or LOW
+  * @param  filter: digital filter applied on break input [0..15], when available
+  * @param  automaticOutput: outputs are automatically enabled again upon next update event
+  *         once break input is inactive. Otherwise resumeOutputs() must be called.
+  * @retval false if timer has no break input
+  */
+bool HardwareTimer::setBreakInput(bool enable, uint32_t polarity, uint32_t filter, bool automaticOutput)
+{
+  TIM_TypeDef *tim = _timerObj.handle.Instance;
+  uint32_t BDTR_RegisterValue;
+
+  if (!IS_TIM_BREAK_INSTANCE(tim)) {
+    return false;
+  }
+
+  BDTR_RegisterValue = tim->BDTR & ~(TIM_BDTR_BKE | TIM_BDTR_BKP | TIM_BDTR_AOE);
+#if defined(TIM_BDTR_BKF)
+  BDTR_RegisterValue &= ~TIM_BDTR_BKF;
+#endif
+  if (enable) {
+    BDTR_RegisterValue |= TIM_BDTR_BKE;
+    if (polarity == HIGH) {
+      BDTR_RegisterValue |= TIM_BDTR_BKP;
+    }
+#if defined(TIM_BDTR_BKF)
+    BDTR_RegisterValue |= (filter << TIM_BDTR_BKF_Pos) & TIM_BDTR_BKF;
+#else
+    UNUSED(filter);
+#endif
+    if (automaticOutput) {
+      BDTR_RegisterValue |= TIM_BDTR_AOE;
+    }
+  }
+  tim->BDTR = BDTR_RegisterValue;
+  return true;
+}
+
+bool HardwareTimer::setBreakInput(bool enable)
+{
+  return setBreakInput(enable, LOW);
+}
+
+#if defined(TIM_BDTR_BK2E)
+/**
+  * @brief  Configure break2 input: when active, all outputs are disabled (set to their inactive state)
+  * @note   Break2 input pin must be configured in its alternate function by user
+  * @param  enable: enable or disable break2 input
+  * @param  polarity: active level of break2 input, HIGH or LOW
+  * @param  filter: digital filter applied on break2 input [0..15]
+  * @retval false if timer has no break2 input
+  */
+bool HardwareTimer::setBreak2Input(bool enable, uint32_t polarity, uint32_t filter)
+{
+  TIM_TypeDef *tim = _timerObj.handle.Instance;
+  uint32_t BDTR_RegisterValue;
+
+  if (!IS_TIM_BKIN2_INSTANCE(tim)) {
+    return false;
+  }
+
+  BDTR_RegisterValue = tim->BDTR & ~(TIM_BDTR_BK2E | TIM_BDTR_BK2P | TIM_BDTR_BK2F);
+  if (enable) {
+    BDTR_RegisterValue |= TIM_BDTR_BK2E | ((filter << TIM_BDTR_BK2F_Pos) & TIM_BDTR_BK2F);
+    if (polarity == HIGH) {
+      BDTR_RegisterValue |= TIM_BDTR_BK2P;
+    }
+  }
+  tim->BDTR = BDTR_RegisterValue;
+  return true;
+}
+
+bool HardwareTimer::setBreak2Input(bool enable)
+{
+  return setBreak2Input(enable, LOW);
+}
+#endif
+
+/**
+  * @brief  Check whether outputs have been disabled by a break event
+  * @retval true if a break occurred and outputs are still disabled
+  */
+bool HardwareTimer::isBreakActive(void)
+{
+  TIM_TypeDef *tim = _timerObj.handle.Instance;
+  uint32_t breakFlags = TIM_SR_BIF;
+#if defined(TIM_SR_B2IF)
+  breakFlags |= TIM_SR_B2IF;
+#endif
+
+  return IS_TIM_BREAK_INSTANCE(tim) && ((tim->BDTR & TIM_BDTR_MOE) == 0) && ((tim->SR & breakFlags) != 0);
+}
+
+/**
+  * @brief  Enable outputs again after a break event.
+  *         Outputs are disabled again if break input is still active.
+  * @retval None
+  */
+void HardwareTimer::resumeOutputs(void)
+{
+  TIM_TypeDef *tim = _timerObj.handle.Instance;
+
+  if (IS_TIM_BREAK_INSTANCE(tim)) {
+    __HAL_TIM_CLEAR_FLAG(&(_timerObj.handle), TIM_FLAG_BREAK);
+#if defined(TIM_FLAG_BREAK2)
+    __HAL_TIM_CLEAR_FLAG(&(_timerObj.handle), TIM_FLAG_BREAK2);
+#endif
+    __HAL_TIM_MOE_ENABLE(&(_timerObj.handle));
+  }
+}
+#endif /* TIM_CCER_CC1NE */
+
 /**
   * @brief  Set the priority of the interrupt
   * @note   Must be call before resume()
@@ -852,18 +1528,18 @@ void HardwareTimer::setInterruptPriority(uint32_t preemptPriority, uint32_t subP
   */
 void HardwareTimer::attachInterrupt(void (*callback)(HardwareTimer *))
 {
-  if (callbacks[0] != NULL) {
-    // Callback previously configured : do not clear neither enable IT, it is just a change of callback
-    callbacks[0] = callback;
-  } else {
-    callbacks[0] = callback;
-    if (callback != NULL) {
-      // Clear flag before enabling IT
-      __HAL_TIM_CLEAR_FLAG(&(_timerObj.handle), TIM_FLAG_UPDATE);
-      // Enable update interrupt only if callback is valid
-      __HAL_TIM_ENABLE_IT(&(_timerObj.handle), TIM_IT_UPDATE);
-    }
-  }
+  setCallback(0, TIM_IT_UPDATE, callback, NULL, NULL);
+}
+
+/**
+  * @brief  Attach interrupt callback with user parameter on update (rollover) event
+  * @param  callback: interrupt callback
+  * @param  arg: parameter given to callback
+  * @retval None
+  */
+void HardwareTimer::attachInterrupt(void (*callback)(void *), void *arg)
+{
+  setCallback(0, TIM_IT_UPDATE, NULL, callback, arg);
 }
 
 /**
@@ -873,8 +1549,11 @@ void HardwareTimer::attachInterrupt(void (*callback)(HardwareTimer *))
 void HardwareTimer::detachInterrupt()
 {
   // Disable update interrupt and clear callback
-  __HAL_TIM_DISABLE_IT(&(_timerObj.handle), TIM_IT_UPDATE); // disables the interrupt call to save cpu cycles for useless context switching
+  if (!_encoderMode) {
+    __HAL_TIM_DISABLE_IT(&(_timerObj.handle), TIM_IT_UPDATE); // disables the interrupt call to save cpu cycles for useless context switching
+  }
   callbacks[0] = NULL;
+  argCallbacks[0] = NULL;
 }
 
 /**
@@ -894,18 +1573,63 @@ void HardwareTimer::attachInterrupt(uint32_t channel, void (*callback)(HardwareT
     Error_Handler();  // only channel 1..4 have an interrupt
   }
 
-  if (callbacks[channel] != NULL) {
-    // Callback previously configured : do not clear neither enable IT, it is just a change of callback
-    callbacks[channel] = callback;
-  } else {
-    callbacks[channel] = callback;
-    if (callback != NULL) {
-      // Clear flag before enabling IT
-      __HAL_TIM_CLEAR_FLAG(&(_timerObj.handle), interrupt);
-      // Enable interrupt corresponding to channel, only if callback is valid
-      __HAL_TIM_ENABLE_IT(&(_timerObj.handle), interrupt);
-    }
+  setCallback(channel, interrupt, callback, NULL, NULL);
+}
+
+/**
+  * @brief  Attach interrupt callback with user parameter on Capture/Compare event
+  * @param  channel: Arduino channel [1..4]
+  * @param  callback: interrupt callback
+  * @param  arg: parameter given to callback
+  * @retval None
+  */
+void HardwareTimer::attachInterrupt(uint32_t channel, void (*callback)(void *), void *arg)
+{
+  int interrupt = getIT(channel);
+  if (interrupt == -1) {
+    Error_Handler();
   }
+
+  if ((channel == 0) || (channel > (TIMER_CHANNELS + 1))) {
+    Error_Handler();  // only channel 1..4 have an interrupt
+  }
+
+  setCallback(channel, interrupt, NULL, callback, arg);
+}
+
+/**
+  * @brief  Store interrupt callback and enable interrupt upon first attachment
+  * @param  index: 0 for update event, Arduino channel [1..4] for Capture/Compare event
+  * @param  interrupt: interrupt corresponding to index
+  * @param  callback: interrupt callback, or NULL
+  * @param  argCallback: interrupt callback with user parameter, or NULL
+  * @param  arg: parameter given to argCallback
+  * @retval None
+  */
+void HardwareTimer::setCallback(uint32_t index, int interrupt, void (*callback)(HardwareTimer *), void (*argCallback)(void *), void *arg)
+{
+  // Callback previously configured : do not clear neither enable IT, it is just a change of callback
+  bool attached = isCallbackAttached(index);
+
+  callbacks[index] = callback;
+  argCallbacks[index] = argCallback;
+  callbackArgs[index] = arg;
+  if (!attached && isCallbackAttached(index)) {
+    // Clear flag before enabling IT
+    __HAL_TIM_CLEAR_FLAG(&(_timerObj.handle), interrupt);
+    // Enable interrupt only if callback is valid
+    __HAL_TIM_ENABLE_IT(&(_timerObj.handle), interrupt);
+  }
+}
+
+/**
+  * @brief  Checks if a callback is attached
+  * @param  index: 0 for update event, Arduino channel [1..4] for Capture/Compare event
+  * @retval true if a callback is attached
+  */
+bool HardwareTimer::isCallbackAttached(uint32_t index)
+{
+  return (callbacks[index] != NULL) || (argCallbacks[index] != NULL);
 }
 
 /**
@@ -927,6 +1651,7 @@ void HardwareTimer::detachInterrupt(uint32_t channel)
   // Disable interrupt corresponding to channel and clear callback
   __HAL_TIM_DISABLE_IT(&(_timerObj.handle), interrupt);
   callbacks[channel] = NULL;
+  argCallbacks[channel] = NULL;
 }
 
 /**
@@ -935,7 +1660,7 @@ void HardwareTimer::detachInterrupt(uint32_t channel)
   */
 bool HardwareTimer::hasInterrupt()
 {
-  return callbacks[0] != NULL;
+  return isCallbackAttached(0);
 }
 
 /**
@@ -948,7 +1673,7 @@ bool HardwareTimer::hasInterrupt(uint32_t channel)
   if ((channel == 0) || (channel > (TIMER_CHANNELS + 1))) {
     Error_Handler();  // only channel 1..4 have an interrupt
   }
-  return callbacks[channel] != NULL;
+  return isCallbackAttached(channel);
 }
 
 /**
@@ -974,6 +1699,220 @@ TIM_HandleTypeDef *HardwareTimer::getHandle()
   return &_timerObj.handle;
 }
 
+/**
+  * @brief  Load channel Capture/Compare register from a buffer upon each update event
+  * @param  channel: Arduino channel [1..4]
+  * @param  buffer: Capture/Compare register values
+  * @param  length: number of values in buffer
+  * @param  circular: restart from the beginning of buffer when its end is reached
+  * @retval true if DMA transfer is started, false otherwise
+  */
+bool HardwareTimer::setCaptureCompareDMA(uint32_t channel, const uint32_t *buffer, uint32_t length, bool circular)
+{
+  if (getChannel(channel) == -1) {
+    return false;
+  }
+  // CCR1 to CCR4 burst base addresses are contiguous
+  return startDMABurst(TIM_DMABASE_CCR1 + (channel - 1), 1, buffer, length, circular);
+}
+
+/**
+  * @brief  Load AutoReload register from a buffer upon each update event
+  * @param  buffer: AutoReload register values (period count - 1)
+  * @param  length: number of values in buffer
+  * @param  circular: restart from the beginning of buffer when its end is reached
+  * @retval true if DMA transfer is started, false otherwise
+  */
+bool HardwareTimer::setOverflowDMA(const uint32_t *buffer, uint32_t length, bool circular)
+{
+  return startDMABurst(TIM_DMABASE_ARR, 1, buffer, length, circular);
+}
+
+/**
+  * @brief  Write a register outside of the timer from a buffer upon each update event
+  * @note   On STM32F2/F4/F7 only DMA2 reaches GPIO registers: use a timer served by DMA2 (TIM1, TIM8),
+  *         false is returned with a DMA1 stream.
+  *         On STM32H7 buffer must not be located in DTCM.
+  * @param  reg: destination register, ex: &GPIOA->BSRR
+  * @param  buffer: register values
+  * @param  length: number of values in buffer
+  * @param  circular: restart from the beginning of buffer when its end is reached
+  * @retval true if DMA transfer is started, false otherwise
+  */
+bool HardwareTimer::setRegisterDMA(__IO uint32_t *reg, const uint32_t *buffer, uint32_t length, bool circular)
+{
+  if ((reg == NULL) || (buffer == NULL)) {
+    return false;
+  }
+  stopDMA();
+  return startDMA(TIM_DMA_UPDATE, 0, DMA_MEMORY_TO_PERIPH, (uint32_t)buffer, (uint32_t)reg, length, circular);
+}
+
+/**
+  * @brief  Load several consecutive timer registers from a buffer upon each update event (DMA burst)
+  * @note   Timer must be configured and resumed by user, first values are applied
+  *         by hardware at the first update event following this call.
+  * @param  baseRegister: first register to load, TIM_DMABASE_xxx ex: TIM_DMABASE_ARR
+  * @param  burstLength: number of registers loaded per update event [1..18]
+  * @param  buffer: register values, burstLength values per update event
+  * @param  length: number of values in buffer, multiple of burstLength
+  * @param  circular: restart from the beginning of buffer when its end is reached
+  * @retval true if DMA transfer is started, false otherwise
+  */
+bool HardwareTimer::startDMABurst(uint32_t baseRegister, uint32_t burstLength, const uint32_t *buffer, uint32_t length, bool circular)
+{
+  TIM_TypeDef *tim = _timerObj.handle.Instance;
+
+  if ((buffer == NULL) || (burstLength == 0) || (burstLength > 18) || ((length % burstLength) != 0)) {
+    return false;
+  }
+  stopDMA();
+  // Each update event requests burstLength transfers to DMAR, redirected from baseRegister
+  tim->DCR = baseRegister | ((burstLength - 1) * TIM_DCR_DBL_0);
+  return startDMA(TIM_DMA_UPDATE, 0, DMA_MEMORY_TO_PERIPH, (uint32_t)buffer, (uint32_t)&tim->DMAR, length, circular);
+}
+
+/**
+  * @brief  Store channel captured values in a ring buffer, without CPU
+  * @note   Channel must be configured in input capture mode and resumed by user.
+  *         Writing position is given by getDMAIndex().
+  * @param  channel: Arduino channel [1..4]
+  * @param  buffer: ring buffer receiving Capture/Compare register values
+  * @param  length: number of values in buffer
+  * @retval true if DMA transfer is started, false otherwise
+  */
+bool HardwareTimer::startCaptureDMA(uint32_t channel, uint32_t *buffer, uint32_t length)
+{
+  if ((getChannel(channel) == -1) || (buffer == NULL)) {
+    return false;
+  }
+  stopDMA();
+  // CCR1 to CCR4 are contiguous, as are CC1DE to CC4DE
+  return startDMA(TIM_DMA_CC1 << (channel - 1), channel, DMA_PERIPH_TO_MEMORY,
+                  (uint32_t)(&_timerObj.handle.Instance->CCR1 + (channel - 1)), (uint32_t)buffer, length, true);
+}
+
+/**
+  * @brief  Configure DMA and enable timer DMA request
+  * @param  dmaSource: TIM_DMA_UPDATE or TIM_DMA_CCx
+  * @param  channel: Arduino channel [1..4] of TIM_DMA_CCx, unused for TIM_DMA_UPDATE
+  * @param  direction: DMA_MEMORY_TO_PERIPH or DMA_PERIPH_TO_MEMORY
+  * @param  srcAddress: source address
+  * @param  dstAddress: destination address
+  * @param  length: number of words to transfer
+  * @param  circular: restart transfer when length is reached
+  * @retval true if DMA transfer is started, false otherwise
+  */
+bool HardwareTimer::startDMA(uint32_t dmaSource, uint32_t channel, uint32_t direction,
+                             uint32_t srcAddress, uint32_t dstAddress, uint32_t length, bool circular)
+{
+  TIM_TypeDef *tim = _timerObj.handle.Instance;
+  DMA_HandleTypeDef *hdma = getDMAHandle();
+
+  if ((hdma == NULL) || (length == 0) || (length > 0xFFFF)) {
+    return false;
+  }
+  // Stream/channel set by user before first use is kept, default one is resolved each time
+  if ((hdma->Instance == NULL) || _dmaDefaultRoute) {
+    bool found = (dmaSource == TIM_DMA_UPDATE) ? getTimerUpDma(tim, hdma) : getTimerCCDma(tim, channel, hdma);
+    if (!found) {
+      return false;
+    }
+    _dmaDefaultRoute = true;
+  }
+#if defined(STM32F2xx) || defined(STM32F4xx) || defined(STM32F7xx)
+  // DMA1 peripheral port is only connected to APB1 peripherals
+  uint32_t periphAddress = (direction == DMA_MEMORY_TO_PERIPH) ? dstAddress : srcAddress;
+  if ((((uint32_t)hdma->Instance - DMA1_BASE) < 0x400U) &&
+      ((periphAddress < APB1PERIPH_BASE) || (periphAddress >= APB2PERIPH_BASE))) {
+    return false;
+  }
+#endif
+  // Stream/channel may be used by another timer or by an ADC/DAC stream
+  if (!acquireDma(hdma)) {
+    return false;
+  }
+
+  hdma->Init.Direction           = direction;
+  hdma->Init.PeriphInc           = DMA_PINC_DISABLE;
+  hdma->Init.MemInc              = DMA_MINC_ENABLE;
+  hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+  hdma->Init.MemDataAlignment    = DMA_MDATAALIGN_WORD;
+  hdma->Init.Mode                = (circular) ? DMA_CIRCULAR : DMA_NORMAL;
+  hdma->Init.Priority            = DMA_PRIORITY_HIGH;
+#if defined(DMA_FIFOMODE_DISABLE)
+  hdma->Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+#endif
+  if (HAL_DMA_Init(hdma) != HAL_OK) {
+    releaseDma(hdma);
+    return false;
+  }
+  if (HAL_DMA_Start(hdma, srcAddress, dstAddress, length) != HAL_OK) {
+    HAL_DMA_DeInit(hdma);
+    releaseDma(hdma);
+    return false;
+  }
+  _dmaSource = dmaSource;
+  _dmaLength = length;
+  __HAL_TIM_ENABLE_DMA(&(_timerObj.handle), dmaSource);
+  return true;
+}
+
+/**
+  * @brief  Stop DMA transfer started by one of DMA functions
+  * @retval None
+  */
+void HardwareTimer::stopDMA(void)
+{
+  if (_dmaSource != 0) {
+    __HAL_TIM_DISABLE_DMA(&(_timerObj.handle), _dmaSource);
+    HAL_DMA_Abort(_hdma);
+    HAL_DMA_DeInit(_hdma);
+    releaseDma(_hdma);
+    _dmaSource = 0;
+  }
+}
+
+/**
+  * @brief  Check DMA transfer state
+  * @retval true while a one-shot transfer is in progress or a circular transfer is running
+  */
+bool HardwareTimer::isDMABusy(void)
+{
+  if (_dmaSource == 0) {
+    return false;
+  }
+  return (_hdma->Init.Mode == DMA_CIRCULAR) || (__HAL_DMA_GET_COUNTER(_hdma) != 0);
+}
+
+/**
+  * @brief  Return position of the next DMA transfer in buffer
+  * @note   For a capture ring buffer, values before this index are the latest captures.
+  * @retval index in buffer [0..length-1], 0 if no DMA transfer
+  */
+uint32_t HardwareTimer::getDMAIndex(void)
+{
+  if (_dmaSource == 0) {
+    return 0;
+  }
+  uint32_t index = _dmaLength - __HAL_DMA_GET_COUNTER(_hdma);
+  return (index < _dmaLength) ? index : 0;
+}
+
+/**
+  * @brief  Return the DMA handle used by DMA functions for more advanced setup
+  * @note   If Instance (and Request/Channel) are set before the first DMA function call,
+  *         they are used instead of the default stream/channel serving the timer.
+  * @retval DMA_HandleTypeDef address, NULL if allocation failed
+  */
+DMA_HandleTypeDef *HardwareTimer::getDMAHandle()
+{
+  if (_hdma == NULL) {
+    _hdma = new DMA_HandleTypeDef();
+  }
+  return _hdma;
+}
+
 /**
   * @brief  Generic Update (rollover) callback which will call user callback
   * @param  htim: HAL timer handle
@@ -988,8 +1927,23 @@ void HardwareTimer::updateCallback(TIM_HandleTypeDef *htim)
   timerObj_t *obj = get_timer_obj(htim);
   HardwareTimer *HT = (HardwareTimer *)(obj->__this);
 
-  if (HT->callbacks[0] != NULL) {
-    HT->callbacks[0](HT);
+  HT->updateHandler();
+}
+
+/**
+  * @brief  Update (rollover) event handler
+  * @retval None
+  */
+void HardwareTimer::updateHandler(void)
+{
+  if (_encoderMode) {
+    encoderSample(true, false);
+  }
+
+  if (callbacks[0] != NULL) {
+    callbacks[0](this);
+  } else if (argCallbacks[0] != NULL) {
+    argCallbacks[0](callbackArgs[0]);
   }
 }
 
@@ -1029,8 +1983,78 @@ void HardwareTimer::captureCompareCallback(TIM_HandleTypeDef *htim)
   timerObj_t *obj = get_timer_obj(htim);
   HardwareTimer *HT = (HardwareTimer *)(obj->__this);
 
-  if (HT->callbacks[channel] != NULL) {
-    HT->callbacks[channel](HT);
+  HT->captureCompareHandler(channel);
+}
+
+/**
+  * @brief  Capture/Compare event handler
+  * @param  channel: Arduino channel [1..4]
+  * @retval None
+  */
+void HardwareTimer::captureCompareHandler(uint32_t channel)
+{
+  if (channel == _encoderSampleChannel) {
+    encoderSample(false, true);
+  } else if (channel == _encoderIndexChannel) {
+    // Position captured by hardware upon index pulse becomes the origin. It
+    // was captured a few edges before current counter value.
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t counter = LL_TIM_GetCounter(_timerObj.handle.Instance);
+    uint32_t captured = __HAL_TIM_GET_COMPARE(&(_timerObj.handle), getChannel(channel));
+    _encoderOffset = getEncoderPosition() + (int16_t)(captured - counter);
+    __set_PRIMASK(primask);
+  }
+
+  if (callbacks[channel] != NULL) {
+    callbacks[channel](this);
+  } else if (argCallbacks[channel] != NULL) {
+    argCallbacks[channel](callbackArgs[channel]);
+  }
+}
+
+/**
+  * @brief  Timer interrupt dispatch. Update and Capture/Compare events are
+  *         handled directly: status register is read once and only handlers
+  *         of pending and enabled events are called. Other events are left to HAL.
+  * @param  obj: timer object
+  * @retval None
+  */
+void HardwareTimer::irqHandler(timerObj_t *obj)
+{
+  TIM_TypeDef *tim = obj->handle.Instance;
+  HardwareTimer *HT = (HardwareTimer *)(obj->__this);
+  // Interrupt enable bits of DIER match status bits of SR
+  uint32_t status = tim->SR & tim->DIER & 0xFFU;
+  uint32_t direct = status & (TIM_FLAG_CC1 | TIM_FLAG_CC2 | TIM_FLAG_CC3 | TIM_FLAG_CC4 | TIM_FLAG_UPDATE);
+
+  if ((HT == NULL) || (direct == 0)) {
+    HAL_TIM_IRQHandler(&obj->handle);
+    return;
+  }
+  // Status flags are cleared by writing 0, other flags are kept.
+  // Same order as HAL: Capture/Compare events then update event. Update flag
+  // is still set while Capture/Compare handlers run, so that they can tell
+  // whether a capture occurred after a rollover not yet handled. Encoder
+  // sample channel comes first, index capture is computed from the sample.
+  tim->SR = ~(direct & ~TIM_FLAG_UPDATE);
+  uint32_t pending = direct;
+  if ((HT->_encoderSampleChannel != 0) && (pending & (TIM_FLAG_CC1 << (HT->_encoderSampleChannel - 1)))) {
+    pending &= ~(TIM_FLAG_CC1 << (HT->_encoderSampleChannel - 1));
+    HT->captureCompareHandler(HT->_encoderSampleChannel);
+  }
+  for (uint32_t channel = 1; channel <= 4; channel++) {
+    if (pending & (TIM_FLAG_CC1 << (channel - 1))) {
+      HT->captureCompareHandler(channel);
+    }
+  }
+  if (direct & TIM_FLAG_UPDATE) {
+    tim->SR = ~TIM_FLAG_UPDATE;
+    HT->updateHandler();
+  }
+
+  if (status != direct) {
+    HAL_TIM_IRQHandler(&obj->handle);
   }
 }
 
@@ -1041,6 +2065,11 @@ void HardwareTimer::captureCompareCallback(TIM_HandleTypeDef *htim)
 HardwareTimer::~HardwareTimer()
 {
   uint32_t index = get_timer_index(_timerObj.handle.Instance);
+  if (_hdma != NULL) {
+    stopDMA();
+    delete _hdma;
+    _hdma = NULL;
+  }
   disableTimerClock(&(_timerObj.handle));
   HardwareTimer_Handle[index] = NULL;
   _timerObj.__this = NULL;
@@ -1338,13 +2367,13 @@ extern "C" {
   void TIM1_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER1_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER1_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER1_INDEX]);
     }
 
 #if defined(STM32F1xx) || defined(STM32F2xx) || defined(STM32F4xx) || defined(STM32F7xx)
 #if defined (TIM10_BASE)
     if (HardwareTimer_Handle[TIMER10_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER10_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER10_INDEX]);
     }
 #endif
 #endif
@@ -1353,7 +2382,7 @@ extern "C" {
     defined(STM32WBxx)
 #if defined (TIM16_BASE)
     if (HardwareTimer_Handle[TIMER16_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER16_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER16_INDEX]);
     }
 #endif
 #endif
@@ -1363,7 +2392,7 @@ extern "C" {
   void TIM1_CC_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER1_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER1_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER1_INDEX]);
     }
   }
 #endif // !STM32F3xx
@@ -1378,7 +2407,7 @@ extern "C" {
   void TIM2_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER2_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER2_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER2_INDEX]);
     }
   }
 #endif //TIM2_BASE
@@ -1392,7 +2421,7 @@ extern "C" {
   void TIM3_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER3_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER3_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER3_INDEX]);
     }
   }
 #endif //TIM3_BASE
@@ -1406,7 +2435,7 @@ extern "C" {
   void TIM4_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER4_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER4_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER4_INDEX]);
     }
   }
 #endif //TIM4_BASE
@@ -1420,7 +2449,7 @@ extern "C" {
   void TIM5_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER5_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER5_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER5_INDEX]);
     }
   }
 #endif //TIM5_BASE
@@ -1434,7 +2463,7 @@ extern "C" {
   void TIM6_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER6_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER6_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER6_INDEX]);
     }
   }
 #endif //TIM6_BASE
@@ -1448,7 +2477,7 @@ extern "C" {
   void TIM7_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER7_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER7_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER7_INDEX]);
     }
   }
 #endif //TIM7_BASE
@@ -1462,13 +2491,13 @@ extern "C" {
   void TIM8_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER8_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER8_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER8_INDEX]);
     }
 
 #if defined(STM32F1xx) || defined(STM32F2xx) ||defined(STM32F4xx) || defined(STM32F7xx) || defined(STM32H7xx)
 #if defined(TIMER13_BASE)
     if (HardwareTimer_Handle[TIMER13_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER13_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER13_INDEX]);
     }
 #endif // TIMER13_BASE
 #endif
@@ -1477,7 +2506,7 @@ extern "C" {
   void TIM8_CC_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER8_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER8_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER8_INDEX]);
     }
   }
 #endif //TIM8_BASE
@@ -1491,7 +2520,7 @@ extern "C" {
   void TIM9_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER9_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER9_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER9_INDEX]);
     }
   }
 #endif //TIM9_BASE
@@ -1506,7 +2535,7 @@ extern "C" {
   void TIM10_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER10_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER10_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER10_INDEX]);
     }
   }
 #endif
@@ -1521,7 +2550,7 @@ extern "C" {
   void TIM11_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER11_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER11_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER11_INDEX]);
     }
   }
 #endif //TIM11_BASE
@@ -1535,7 +2564,7 @@ extern "C" {
   void TIM12_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER12_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER12_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER12_INDEX]);
     }
   }
 #endif //TIM12_BASE
@@ -1550,7 +2579,7 @@ extern "C" {
   void TIM13_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER13_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER13_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER13_INDEX]);
     }
   }
 #endif
@@ -1565,7 +2594,7 @@ extern "C" {
   void TIM14_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER14_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER14_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER14_INDEX]);
     }
   }
 #endif //TIM14_BASE
@@ -1579,7 +2608,7 @@ extern "C" {
   void TIM15_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER15_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER15_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER15_INDEX]);
     }
   }
 #endif //TIM15_BASE
@@ -1594,7 +2623,7 @@ extern "C" {
   void TIM16_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER16_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER16_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER16_INDEX]);
     }
   }
 #endif
@@ -1609,7 +2638,7 @@ extern "C" {
   void TIM17_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER17_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER17_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER17_INDEX]);
     }
   }
 #endif //TIM17_BASE
@@ -1623,13 +2652,13 @@ extern "C" {
   void TIM18_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER18_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER18_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER18_INDEX]);
     }
 
 #if defined(STM32F3xx)
 #if defined (TIM1_BASE)
     if (HardwareTimer_Handle[TIMER1_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER1_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER1_INDEX]);
     }
 #endif
 #endif
@@ -1645,7 +2674,7 @@ extern "C" {
   void TIM19_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER19_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER19_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER19_INDEX]);
     }
   }
 #endif //TIM19_BASE
@@ -1659,14 +2688,14 @@ extern "C" {
   void TIM20_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER20_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER20_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER20_INDEX]);
     }
   }
 
   void TIM20_CC_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER20_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER20_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER20_INDEX]);
     }
   }
 #endif //TIM20_BASE
@@ -1680,7 +2709,7 @@ extern "C" {
   void TIM21_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER21_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER21_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER21_INDEX]);
     }
   }
 #endif //TIM21_BASE
@@ -1694,7 +2723,7 @@ extern "C" {
   void TIM22_IRQHandler(void)
   {
     if (HardwareTimer_Handle[TIMER22_INDEX] != NULL) {
-      HAL_TIM_IRQHandler(&HardwareTimer_Handle[TIMER22_INDEX]->handle);
+      HardwareTimer::irqHandler(HardwareTimer_Handle[TIMER22_INDEX]);
     }
   }
 #endif //TIM22_BASE
@@ -57,6 +57,12 @@ typedef enum {
   // This mode is very useful for Frequency and Dutycycle measurement
   TIMER_INPUT_FREQ_DUTY_MEASUREMENT,
 
+  // Quadrature encoder interface: counter is driven by channel 1 and channel 2 inputs.
+  // Both channels must be configured with the same mode, see getEncoderCount()
+  TIMER_ENCODER_TI1,                      // == LL_TIM_ENCODERMODE_X2_TI1   counter counts on channel 1 edges
+  TIMER_ENCODER_TI2,                      // == LL_TIM_ENCODERMODE_X2_TI2   counter counts on channel 2 edges
+  TIMER_ENCODER_TI12,                     // == LL_TIM_ENCODERMODE_X4_TI12  counter counts on channel 1 and channel 2 edges
+
   TIMER_NOT_USED = 0xFFFF  // This must be the last item of this enum
 } TimerModes_t;
 
@@ -90,6 +96,22 @@ typedef enum {
   PERCENT_COMPARE_FORMAT, // used for Dutycycle
 } TimerCompareFormat_t;
 
+typedef enum {
+  TIMER_SLAVE_DISABLED,                   // == TIM_SLAVEMODE_DISABLE       counter clocked by internal clock
+  TIMER_SLAVE_RESET,                      // == TIM_SLAVEMODE_RESET         counter is reinitialized upon trigger rising edge
+  TIMER_SLAVE_GATED,                      // == TIM_SLAVEMODE_GATED         counter runs while trigger is high
+  TIMER_SLAVE_TRIGGER,                    // == TIM_SLAVEMODE_TRIGGER       counter starts upon trigger rising edge
+  TIMER_SLAVE_EXTERNAL_CLOCK,             // == TIM_SLAVEMODE_EXTERNAL1     counter is clocked by trigger rising edges (timer used as prescaler of another one)
+} TimerSlaveModes_t;
+
+typedef enum {
+  TIMER_COUNTER_UP,                       // == TIM_COUNTERMODE_UP              default, edge-aligned
+  TIMER_COUNTER_DOWN,                     // == TIM_COUNTERMODE_DOWN
+  TIMER_COUNTER_CENTER_DOWN,              // == TIM_COUNTERMODE_CENTERALIGNED1  counts up and down, compare interrupt flags are set when counting down
+  TIMER_COUNTER_CENTER_UP,                // == TIM_COUNTERMODE_CENTERALIGNED2  compare interrupt flags are set when counting up
+  TIMER_COUNTER_CENTER_UP_DOWN,           // == TIM_COUNTERMODE_CENTERALIGNED3  compare interrupt flags are set when counting up and down
+} TimerCounterModes_t;
+
 #ifdef __cplusplus
 
 /* Class --------------------------------------------------------*/
@@ -118,11 +140,49 @@ class HardwareTimer {
 
     void setMode(uint32_t channel, TimerModes_t mode, PinName pin = NC); // Configure timer channel with specified mode on specified pin if available
     void setMode(uint32_t channel, TimerModes_t mode, uint32_t pin);
+#if defined(TIM_CCER_CC1NE)
+    void setMode(uint32_t channel, TimerModes_t mode, PinName pin, PinName pinN); // Configure timer channel with both outputs: pin on CHx and complementary pinN on CHxN
+    void setMode(uint32_t channel, TimerModes_t mode, uint32_t pin, uint32_t pinN);
+#endif
 
     uint32_t getCaptureCompare(uint32_t channel, TimerCompareFormat_t format = TICK_COMPARE_FORMAT); // return Capture/Compare register value of specified channel depending on format provided
 
     void setCaptureCompare(uint32_t channel, uint32_t compare, TimerCompareFormat_t format = TICK_COMPARE_FORMAT);  // set Compare register value of specified channel depending on format provided
 
+    // Encoder: 32-bit position extended from the 16-bit counter, sampled on rollover and half a period away from last sample
+    int32_t getEncoderCount(void);  // return encoder position
+    void setEncoderCount(int32_t count);  // set encoder position
+    void setEncoderIndex(PinName pin, uint32_t mode);  // reset encoder position upon index pulse (RISING, FALLING or CHANGE)
+    void setEncoderIndex(uint32_t pin, uint32_t mode);
+    void setEncoderIndex(PinName pin);  // same as above with RISING mode
+    void setEncoderIndex(uint32_t pin);
+
+    // Synchronization: trigger output (TRGO) of a master timer resets, gates, starts or clocks slave timers
+    bool setTriggerOutput(uint32_t trigger, bool masterSlaveMode = false); // select event sent on TRGO: TIM_TRGO_xxx ex: TIM_TRGO_UPDATE. masterSlaveMode delays own trigger input for exact synchronization with slaves
+    bool setSlaveMode(TimerSlaveModes_t mode, uint32_t trigger = TIM_TS_ITR0); // select slave mode and trigger input: TIM_TS_ITRx (TRGO of another timer, see reference manual), TIM_TS_TI1FP1, TIM_TS_TI2FP2...
+
+    // One pulse: once started, by startPulse() or by trigger input, pin becomes active after delay during width, then counter stops. Durations in nanoseconds
+    void setOnePulse(uint32_t channel, PinName pin, uint32_t delay, uint32_t width);
+    void setOnePulse(uint32_t channel, uint32_t pin, uint32_t delay, uint32_t width);
+    bool setPulseTrigger(uint32_t trigger, bool retriggerable = false); // pulse started upon trigger input: TIM_TS_TI1FP1 (channel 1 configured as input capture), TIM_TS_ITRx... retriggerable: a trigger during pulse restarts it (when supported)
+    void startPulse(void); // software start of pulse
+    bool isPulseRunning(void);
+
+    void setCounterMode(TimerCounterModes_t mode); // to be called while timer is paused. In center-aligned modes, period is twice the overflow and HERTZ/MICROSEC formats take it into account
+
+#if defined(TIM_CCER_CC1NE)
+    // Advanced timers (break instances): dead-time between complementary outputs, and break inputs disabling all outputs
+    bool setDeadTime(uint32_t nanoseconds); // dead-time inserted on complementary outputs. Clock division (also used by input filters) is increased for long dead-times
+    bool setBreakInput(bool enable, uint32_t polarity, uint32_t filter = 0, bool automaticOutput = false); // break active on polarity level (HIGH or LOW). automaticOutput re-enables outputs upon next update event
+    bool setBreakInput(bool enable);  // same as above with LOW polarity
+#if defined(TIM_BDTR_BK2E)
+    bool setBreak2Input(bool enable, uint32_t polarity, uint32_t filter = 0);
+    bool setBreak2Input(bool enable);
+#endif
+    bool isBreakActive(void);  // returns true if outputs have been disabled by a break event
+    void resumeOutputs(void);  // enable outputs again after a break event
+#endif
+
     void setInterruptPriority(uint32_t preemptPriority, uint32_t subPriority); // set interrupt priority
 
     //Add interrupt to period update
@@ -131,9 +191,24 @@ class HardwareTimer {
     bool hasInterrupt();  //returns true if a timer rollover interrupt has already been set
     //Add interrupt to capture/compare channel
     void attachInterrupt(uint32_t channel, void (*handler)(HardwareTimer *)); // Attach interrupt callback which will be called upon compare match event of specified channel
+    // Same with a user parameter given back to callback, ex: object pointer
+    void attachInterrupt(void (*handler)(void *), void *arg);
+    void attachInterrupt(uint32_t channel, void (*handler)(void *), void *arg);
     void detachInterrupt(uint32_t channel);  // remove interrupt callback which was attached to compare match event of specified channel
     bool hasInterrupt(uint32_t channel);  //returns true if an interrupt has already been set on the channel compare match
 
+    // DMA: registers are loaded from a buffer upon each update event (timer rollover), or captures are stored in a buffer, without CPU.
+    // Buffer holds raw register values, it must remain valid until transfer is complete (or stopped in circular mode).
+    // Only one DMA transfer at a time per timer
+    bool setCaptureCompareDMA(uint32_t channel, const uint32_t *buffer, uint32_t length, bool circular = false); // one Capture/Compare register value per period
+    bool setOverflowDMA(const uint32_t *buffer, uint32_t length, bool circular = false); // one AutoReload register value per period
+    bool setRegisterDMA(__IO uint32_t *reg, const uint32_t *buffer, uint32_t length, bool circular = false); // one value written to any register per period, ex: GPIO BSRR
+    bool startDMABurst(uint32_t baseRegister, uint32_t burstLength, const uint32_t *buffer, uint32_t length, bool circular = false); // burstLength registers from baseRegister (TIM_DMABASE_xxx) per period
+    bool startCaptureDMA(uint32_t channel, uint32_t *buffer, uint32_t length); // captured values of channel are stored in buffer, used as a ring buffer
+    void stopDMA(void);
+    bool isDMABusy(void);  // returns true while a one-shot transfer is in progress or a circular transfer is running
+    uint32_t getDMAIndex(void);  // returns index in buffer of the next DMA transfer
+
     void timerHandleDeinit();  // Timer deinitialization
 
     // Refresh() is usefull while timer is running after some registers update
@@ -144,20 +219,45 @@ class HardwareTimer {
 
     static void captureCompareCallback(TIM_HandleTypeDef *htim); // Generic Caputre and Compare callback which will call user callback
     static void updateCallback(TIM_HandleTypeDef *htim);  // Generic Update (rollover) callback which will call user callback
+    static void irqHandler(timerObj_t *obj);  // Timer interrupt dispatch: status register is read once and only pending callbacks are called
 
     // The following function(s) are available for more advanced timer options
     TIM_HandleTypeDef *getHandle();  // return the handle address for HAL related configuration
+    DMA_HandleTypeDef *getDMAHandle();  // return the DMA handle address, used by DMA functions. Stream/channel selection is kept if already set
 
   private:
     TimerModes_t  _ChannelMode[TIMER_CHANNELS];
     timerObj_t _timerObj;
+    DMA_HandleTypeDef *_hdma;  // allocated on first DMA use
+    uint32_t _dmaSource;  // TIM_DMA_xxx request in use, 0 if none
+    uint32_t _dmaLength;
+    bool _dmaDefaultRoute;
+    bool _encoderMode;
+    uint32_t _encoderIndexChannel;  // channel capturing encoder index, 0 if none
+    uint32_t _onePulseChannel;  // channel generating one pulse, 0 if none
+    uint32_t _encoderSampleChannel;  // output compare channel sampling encoder counter half a period away, 0 if none
+    volatile uint32_t _encoderCounter;  // counter value of last sample
+    volatile int32_t _encoderBase;  // position at last sample, not including offset
+    volatile int32_t _encoderOffset;
+    int32_t getEncoderRawCount(uint32_t counter, bool rollover, bool midRange);
+    int32_t getEncoderPosition(void);
+    void encoderSample(bool rollover, bool midRange);
+    void setEncoderSampleChannel(uint32_t channel);
     void (*callbacks[1 + TIMER_CHANNELS])(HardwareTimer *); //Callbacks: 0 for update, 1-4 for channels. (channel5/channel6, if any, doesn't have interrupt)
+    void (*argCallbacks[1 + TIMER_CHANNELS])(void *);  // Callbacks with user parameter, same index as callbacks
+    void *callbackArgs[1 + TIMER_CHANNELS];
+    bool isCallbackAttached(uint32_t index);
+    void setCallback(uint32_t index, int interrupt, void (*callback)(HardwareTimer *), void (*argCallback)(void *), void *arg);
+    void updateHandler(void);
+    void captureCompareHandler(uint32_t channel);
     int getChannel(uint32_t channel);
     int getLLChannel(uint32_t channel);
     int getIT(uint32_t channel);
     int getAssociatedChannel(uint32_t channel);
+    bool startDMA(uint32_t dmaSource, uint32_t channel, uint32_t direction, uint32_t srcAddress, uint32_t dstAddress, uint32_t length, bool circular);
 #if defined(TIM_CCER_CC1NE)
     bool isComplementaryChannel[TIMER_CHANNELS];
+    bool isComplementaryPair[TIMER_CHANNELS];  // both CHx and CHxN outputs are used
 #endif
 };
 
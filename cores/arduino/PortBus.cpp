@@ -0,0 +1,154 @@
+/*
+  Copyright (c) 2020 STMicroelectronics. All right reserved.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "Arduino.h"
+#include "PortBus.h"
+
+// Compiled to a single ror instruction
+static inline uint32_t rotateRight(uint32_t value, uint32_t shift)
+{
+  return (value >> shift) | (value << ((32 - shift) & 0x1F));
+}
+
+PortBus::PortBus(const uint32_t *pins, uint32_t count) :
+  _portCount(0)
+#if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
+  , _streamTimer(NULL)
+#endif
+{
+  PinName names[PORTBUS_MAX_PINS];
+  uint8_t runCount = 0;
+
+  if (count > PORTBUS_MAX_PINS) {
+    count = PORTBUS_MAX_PINS;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    names[i] = digitalPinToPinName(pins[i]);
+  }
+
+  // Group pins by port, then by offset between bus bit and port bit
+  for (uint32_t i = 0; i < count; i++) {
+    if ((names[i] == NC) || !STM_VALID_PINNAME(names[i])) {
+      continue;
+    }
+    PortName port = (PortName)STM_PORT(names[i]);
+    uint32_t p;
+    for (p = 0; (p < _portCount) && (_ports[p].port != port); p++);
+    if (p < _portCount) {
+      continue;  // port already done
+    }
+    portbus_port_t *bus = &_ports[_portCount++];
+    bus->gpio = get_GPIO_Port(port);
+    bus->port = port;
+    bus->mask = 0;
+    bus->firstRun = runCount;
+    bus->runCount = 0;
+
+    for (uint32_t j = i; j < count; j++) {
+      if ((names[j] == NC) || !STM_VALID_PINNAME(names[j]) || (STM_PORT(names[j]) != port) ||
+          (bus->mask & STM_GPIO_PIN(names[j]))) {
+        continue;
+      }
+      uint8_t shift = (STM_PIN(names[j]) - j) & 0x1F;
+      uint32_t r;
+      for (r = bus->firstRun; (r < runCount) && (_runs[r].shift != shift); r++);
+      if (r == runCount) {
+        _runs[runCount].valueMask = 0;
+        _runs[runCount].portMask = 0;
+        _runs[runCount].shift = shift;
+        runCount++;
+        bus->runCount++;
+      }
+      _runs[r].valueMask |= (1UL << j);
+      _runs[r].portMask |= STM_GPIO_PIN(names[j]);
+      bus->mask |= STM_GPIO_PIN(names[j]);
+    }
+  }
+}
+
+void PortBus::begin(uint32_t mode)
+{
+  for (uint32_t p = 0; p < _portCount; p++) {
+    for (uint32_t pin = 0; pin < 16; pin++) {
+      if (_ports[p].mask & (1UL << pin)) {
+        pinMode(pinNametoDigitalPin((PinName)((_ports[p].port << 4) | pin)), mode);
+      }
+    }
+  }
+}
+
+void PortBus::write(uint32_t value)
+{
+  for (uint32_t p = 0; p < _portCount; p++) {
+    _ports[p].gpio->BSRR = scatter(&_ports[p], value);
+  }
+}
+
+uint32_t PortBus::read(void)
+{
+  uint32_t value = 0;
+  for (uint32_t p = 0; p < _portCount; p++) {
+    const portbus_run_t *run = &_runs[_ports[p].firstRun];
+    uint32_t idr = _ports[p].gpio->IDR;
+    for (uint32_t r = 0; r < _ports[p].runCount; r++, run++) {
+      value |= rotateRight(idr & run->portMask, run->shift);
+    }
+  }
+  return value;
+}
+
+uint32_t PortBus::getBSRR(uint32_t value)
+{
+  return (_portCount == 1) ? scatter(&_ports[0], value) : 0;
+}
+
+/*
+ * \brief BSRR value of one port: bits to set in lower half, bits to reset in upper half.
+ */
+uint32_t PortBus::scatter(const portbus_port_t *port, uint32_t value)
+{
+  const portbus_run_t *run = &_runs[port->firstRun];
+  uint32_t set = 0;
+  for (uint32_t r = 0; r < port->runCount; r++, run++) {
+    set |= rotateRight(value & run->valueMask, (32 - run->shift) & 0x1F);
+  }
+  return set | ((port->mask & ~set) << 16);
+}
+
+#if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
+bool PortBus::startStream(HardwareTimer *timer, const uint32_t *buffer, uint32_t length, bool circular)
+{
+  if ((timer == NULL) || (_portCount != 1)) {
+    return false;
+  }
+  stopStream();
+  if (!timer->setRegisterDMA(&_ports[0].gpio->BSRR, buffer, length, circular)) {
+    return false;
+  }
+  _streamTimer = timer;
+  return true;
+}
+
+void PortBus::stopStream(void)
+{
+  if (_streamTimer != NULL) {
+    _streamTimer->stopDMA();
+    _streamTimer = NULL;
+  }
+}
+#endif /* HAL_TIM_MODULE_ENABLED && !HAL_TIM_MODULE_ONLY */
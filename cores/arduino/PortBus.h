@@ -0,0 +1,105 @@
+/*
+  Copyright (c) 2020 STMicroelectronics. All right reserved.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _PORTBUS_H_
+#define _PORTBUS_H_
+
+#include "HardwareTimer.h"
+
+#ifdef __cplusplus
+
+#ifndef PORTBUS_MAX_PINS
+#define PORTBUS_MAX_PINS 32
+#endif
+
+/*
+ * \brief Group of pins accessed as a parallel bus, ex: 8/16-bit LCD data lines.
+ * Pin to port bit mapping is computed once by the constructor: write() does
+ * one BSRR store per GPIO port involved, read() one IDR load per port.
+ * Pins which keep the same offset between their bus bit and their port bit
+ * are moved together with a single mask and rotate.
+ */
+class PortBus {
+  public:
+    /*
+     * \param pins Arduino pins, pins[0] is bit 0 of the bus value
+     * \param count Number of pins, up to PORTBUS_MAX_PINS. Invalid or
+     *              duplicated pins are ignored (their bit reads as 0).
+     */
+    PortBus(const uint32_t *pins, uint32_t count);
+
+    /*
+     * \brief Configure all pins of the bus, ex: OUTPUT or INPUT_PULLUP.
+     */
+    void begin(uint32_t mode);
+
+    void write(uint32_t value);
+    uint32_t read(void);
+
+    /*
+     * \brief BSRR value writing the bus value on a single port bus,
+     * used to fill startStream() buffer. 0 if bus spans several ports.
+     */
+    uint32_t getBSRR(uint32_t value);
+
+    bool isSinglePort(void)
+    {
+      return (_portCount == 1);
+    }
+
+#if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
+    /*
+     * \brief Write buffer on the bus by DMA, one value upon each update event
+     * of timer, without CPU. Bus must use a single port.
+     *
+     * \param timer Timer pacing the transfer, configured and resumed by user
+     * \param buffer BSRR values returned by getBSRR(), must remain valid
+     *               until transfer is complete (or stopped in circular mode)
+     * \return false if bus spans several ports or DMA is not available
+     */
+    bool startStream(HardwareTimer *timer, const uint32_t *buffer, uint32_t length, bool circular = false);
+    void stopStream(void);
+#endif
+
+  private:
+    typedef struct {
+      GPIO_TypeDef *gpio;
+      PortName port;
+      uint32_t mask;  // port pins used by the bus
+      uint8_t firstRun;
+      uint8_t runCount;
+    } portbus_port_t;
+
+    typedef struct {
+      uint32_t valueMask;  // bus bits moved by this run
+      uint32_t portMask;  // matching port bits
+      uint8_t shift;  // port bit - bus bit, modulo 32
+    } portbus_run_t;
+
+    portbus_port_t _ports[MAX_NB_PORT];
+    portbus_run_t _runs[PORTBUS_MAX_PINS];
+    uint8_t _portCount;
+    uint32_t scatter(const portbus_port_t *port, uint32_t value);
+#if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
+    HardwareTimer *_streamTimer;
+#endif
+};
+
+#endif /* __cplusplus */
+
+#endif /* _PORTBUS_H_ */
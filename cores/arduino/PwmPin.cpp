@@ -0,0 +1,82 @@
+/*
+  Copyright (c) 2020 STMicroelectronics. All right reserved.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "Arduino.h"
+#include "PwmPin.h"
+
+#if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
+
+// Number of started PwmPin per timer: registers of the timer are written by
+// write() of each of them, it is released only by end() of the last one
+static uint8_t PwmPin_started[TIMER_NUM];
+
+PwmPin::PwmPin(uint32_t pin) : PwmPin(digitalPinToPinName(pin))
+{
+}
+
+PwmPin::PwmPin(PinName pin) :
+  _pin(pin), _ccr(&_unused), _arr(&_unused), _max(1), _unused(0)
+{
+}
+
+bool PwmPin::begin(void)
+{
+  return begin(PWM_FREQUENCY, (TimerCompareFormat_t)PWM_RESOLUTION);
+}
+
+bool PwmPin::begin(uint32_t frequency, TimerCompareFormat_t resolution)
+{
+  if ((_pin == NC) || !pin_in_pinmap(_pin, PinMap_PWM) ||
+      (resolution < RESOLUTION_1B_COMPARE_FORMAT) || (resolution > RESOLUTION_16B_COMPARE_FORMAT)) {
+    return false;
+  }
+  end();
+  pwm_start(_pin, frequency, 0, resolution);
+
+  TIM_TypeDef *Instance = (TIM_TypeDef *)pinmap_peripheral(_pin, PinMap_PWM);
+  uint32_t channel = STM_PIN_CHANNEL(pinmap_function(_pin, PinMap_PWM));
+  _ccr = &Instance->CCR1 + (channel - 1);
+  _arr = &Instance->ARR;
+  _max = (1 << resolution) - 1;
+  PwmPin_started[get_timer_index(Instance)]++;
+  return true;
+}
+
+void PwmPin::end(void)
+{
+  if (_ccr != &_unused) {
+    TIM_TypeDef *Instance = (TIM_TypeDef *)pinmap_peripheral(_pin, PinMap_PWM);
+    timer_index_t index = get_timer_index(Instance);
+
+    _ccr = &_unused;
+    _arr = &_unused;
+    if (PwmPin_started[index] > 1) {
+      // Other PwmPin use the timer: only the channel of the pin is stopped
+      PwmPin_started[index]--;
+      if (HardwareTimer_Handle[index] != NULL) {
+        HardwareTimer *HT = (HardwareTimer *)(HardwareTimer_Handle[index]->__this);
+        HT->pauseChannel(STM_PIN_CHANNEL(pinmap_function(_pin, PinMap_PWM)));
+      }
+    } else {
+      PwmPin_started[index] = 0;
+      pwm_stop(_pin);
+    }
+  }
+}
+
+#endif /* HAL_TIM_MODULE_ENABLED && !HAL_TIM_MODULE_ONLY */
@@ -0,0 +1,87 @@
+/*
+  Copyright (c) 2020 STMicroelectronics. All right reserved.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _PWMPIN_H_
+#define _PWMPIN_H_
+
+#include "HardwareTimer.h"
+
+#if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
+
+#ifdef __cplusplus
+
+/*
+ * \brief PWM output handle. The timer channel of the pin is resolved once by
+ * begin(), then write() only stores the compare register.
+ */
+class PwmPin {
+  public:
+    PwmPin(uint32_t pin);
+    PwmPin(PinName pin);
+
+    /*
+     * \brief Start the PWM with a 0 duty cycle.
+     *
+     * \param frequency PWM frequency (in hertz), PWM_FREQUENCY if not given
+     * \param resolution Resolution of the values given to write(),
+     *                   PWM_RESOLUTION if not given
+     * \return false if the pin has no PWM capability
+     */
+    bool begin(void);
+    bool begin(uint32_t frequency, TimerCompareFormat_t resolution);
+
+    /*
+     * \brief Stop the PWM. The timer is released when no other started
+     * PwmPin uses it, otherwise only the channel of the pin is stopped.
+     */
+    void end(void);
+
+    /*
+     * \brief Set the duty cycle, value is in the resolution given to begin().
+     */
+    inline void write(uint32_t value)
+    {
+      *_ccr = ((*_arr + 1) * value) / _max;
+    }
+
+    /*
+     * \brief Set the duty cycle in timer ticks, from 0 to getPeriodTicks().
+     */
+    inline void writeTicks(uint32_t ticks)
+    {
+      *_ccr = ticks;
+    }
+
+    inline uint32_t getPeriodTicks(void)
+    {
+      return *_arr + 1;
+    }
+
+  private:
+    PinName _pin;
+    __IO uint32_t *_ccr;
+    __IO uint32_t *_arr;
+    uint32_t _max;
+    uint32_t _unused;  // target of _ccr and _arr when not started
+};
+
+#endif /* __cplusplus */
+
+#endif /* HAL_TIM_MODULE_ENABLED && !HAL_TIM_MODULE_ONLY */
+
+#endif /* _PWMPIN_H_ */
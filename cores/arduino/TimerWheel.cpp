@@ -0,0 +1,381 @@
+/*
+  Copyright (c) 2020 STMicroelectronics. All right reserved.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "Arduino.h"
+#include "TimerWheel.h"
+
+#if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
+
+#if (TIMER_WHEEL_LEVELS < 1) || (TIMER_WHEEL_LEVELS > 5)
+#error "TIMER_WHEEL_LEVELS must be in range 1..5"
+#endif
+
+#define WHEEL_BITS          6
+#define WHEEL_SLOT_MASK     0x3FU
+#define WHEEL_TOP_SHIFT     (WHEEL_BITS * (TIMER_WHEEL_LEVELS - 1))
+#define WHEEL_RANGE         (1UL << (WHEEL_BITS * TIMER_WHEEL_LEVELS))
+
+/* Maximum delay between 2 compare events, so that the 16-bit counter
+   can be extended without missing a rollover */
+#define WHEEL_MAX_SLEEP     0x8000U
+
+/**
+  * @brief  TimerWheel constructor
+  * @param  instance: timer instance used as time base
+  * @retval None
+  */
+TimerWheel::TimerWheel(TIM_TypeDef *instance) :
+  _instance(instance), _timer(NULL), _lastTime(0), _wheelTime(0)
+{
+  for (uint32_t level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+    _occupied[level] = 0;
+    for (uint32_t slot = 0; slot < 64; slot++) {
+      _slots[level][slot] = NULL;
+    }
+  }
+}
+
+/**
+  * @brief  TimerWheel destructor
+  * @retval None
+  */
+TimerWheel::~TimerWheel()
+{
+  end();
+}
+
+/**
+  * @brief  Configure the timer: 1MHz 16-bit counter, channel 1 in output compare
+  * @retval None
+  */
+void TimerWheel::begin(void)
+{
+  if (_timer != NULL) {
+    return;
+  }
+  _timer = new HardwareTimer(_instance);
+
+  _timer->setPrescaleFactor(_timer->getTimerClkFreq() / 1000000);
+  _timer->setOverflow(0x10000);
+  _timer->setMode(1, TIMER_OUTPUT_COMPARE);
+  _timer->setCaptureCompare(1, WHEEL_MAX_SLEEP);
+  _timer->attachInterrupt(1, compareCallback, this);
+  _timer->refresh();
+  _lastTime = 0;
+  _wheelTime = 0;
+  _timer->resume();
+}
+
+/**
+  * @brief  Stop the timer and cancel all software timers
+  * @retval None
+  */
+void TimerWheel::end(void)
+{
+  if (_timer == NULL) {
+    return;
+  }
+  _timer->pause();
+  delete _timer;
+  _timer = NULL;
+
+  for (uint32_t level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+    _occupied[level] = 0;
+    for (uint32_t slot = 0; slot < 64; slot++) {
+      Event *event = _slots[level][slot];
+      while (event != NULL) {
+        event->pprev = NULL;
+        event = event->next;
+      }
+      _slots[level][slot] = NULL;
+    }
+  }
+}
+
+/**
+  * @brief  Start a software timer, restart it if already started
+  * @param  event: software timer
+  * @param  delay: first expiration delay in microseconds
+  * @param  period: period in microseconds, 0 for one-shot
+  * @param  callback: function called upon expiration
+  * @param  arg: parameter of callback
+  * @retval None
+  */
+void TimerWheel::start(Event *event, uint32_t delay, uint32_t period, callback_t callback, void *arg)
+{
+  if ((_timer == NULL) || (event == NULL) || (callback == NULL)) {
+    return;
+  }
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  if (event->pprev != NULL) {
+    unlink(event);
+  }
+  event->expires = now() + delay;
+  event->period = period;
+  event->callback = callback;
+  event->arg = arg;
+  insert(event);
+  program();
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Cancel a software timer
+  * @param  event: software timer
+  * @retval None
+  */
+void TimerWheel::cancel(Event *event)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  if ((event != NULL) && (event->pprev != NULL)) {
+    unlink(event);
+  }
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Check whether a software timer is started
+  * @param  event: software timer
+  * @retval true if it will expire
+  */
+bool TimerWheel::isActive(Event *event)
+{
+  return (event != NULL) && (event->pprev != NULL);
+}
+
+/**
+  * @brief  Current time of the wheel. The 16-bit counter is extended
+  *         to 32 bits, wheel interrupt occurs at least every 32ms.
+  * @retval time in microseconds
+  */
+uint32_t TimerWheel::now(void)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  _lastTime += (uint16_t)(LL_TIM_GetCounter(_instance) - _lastTime);
+  uint32_t time = _lastTime;
+  __set_PRIMASK(primask);
+  return time;
+}
+
+/**
+  * @brief  Link a software timer in its slot. Level is the lowest one where
+  *         expiration and wheel time have the same upper digits.
+  * @note   Interrupts must be disabled
+  * @param  event: software timer
+  * @retval None
+  */
+void TimerWheel::insert(Event *event)
+{
+  uint32_t expires = event->expires;
+  uint32_t level;
+  uint32_t slot;
+
+  /* Late expirations are handled on next tick */
+  if ((int32_t)(expires - _wheelTime) < 0) {
+    expires = _wheelTime;
+  }
+  for (level = 0; level < (TIMER_WHEEL_LEVELS - 1); level++) {
+    uint32_t shift = WHEEL_BITS * (level + 1);
+    if ((expires >> shift) == (_wheelTime >> shift)) {
+      break;
+    }
+  }
+  if (level < (TIMER_WHEEL_LEVELS - 1)) {
+    slot = (expires >> (WHEEL_BITS * level)) & WHEEL_SLOT_MASK;
+  } else if ((expires - _wheelTime) < (WHEEL_RANGE - (1UL << WHEEL_TOP_SHIFT))) {
+    slot = (expires >> WHEEL_TOP_SHIFT) & WHEEL_SLOT_MASK;
+  } else {
+    /* Out of range: use the last slot of the rotation, it is rescheduled when reached */
+    slot = ((_wheelTime >> WHEEL_TOP_SHIFT) - 1) & WHEEL_SLOT_MASK;
+  }
+
+  Event **head = &_slots[level][slot];
+  event->next = *head;
+  if (*head != NULL) {
+    (*head)->pprev = &event->next;
+  }
+  *head = event;
+  event->pprev = head;
+  event->level = level;
+  event->slot = slot;
+  _occupied[level] |= (1ULL << slot);
+}
+
+/**
+  * @brief  Unlink a software timer from its list
+  * @note   Interrupts must be disabled
+  * @param  event: software timer
+  * @retval None
+  */
+void TimerWheel::unlink(Event *event)
+{
+  *event->pprev = event->next;
+  if (event->next != NULL) {
+    event->next->pprev = event->pprev;
+  }
+  event->next = NULL;
+  event->pprev = NULL;
+  if (_slots[event->level][event->slot] == NULL) {
+    _occupied[event->level] &= ~(1ULL << event->slot);
+  }
+}
+
+/**
+  * @brief  Move the content of a slot in a separate list
+  * @note   Interrupts must be disabled
+  * @param  level: wheel level
+  * @param  slot: slot in level
+  * @param  list: list head
+  * @retval None
+  */
+void TimerWheel::detach(uint32_t level, uint32_t slot, Event **list)
+{
+  *list = _slots[level][slot];
+  if (*list != NULL) {
+    (*list)->pprev = list;
+  }
+  _slots[level][slot] = NULL;
+  _occupied[level] &= ~(1ULL << slot);
+}
+
+/**
+  * @brief  Next tick where a slot expires or must be cascaded
+  * @param  tick: next tick
+  * @retval false if no software timer is started
+  */
+bool TimerWheel::nextTick(uint32_t *tick)
+{
+  uint32_t distance = 0xFFFFFFFF;
+  bool found = false;
+
+  for (uint32_t level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+    uint64_t bits = _occupied[level];
+    if (bits == 0) {
+      continue;
+    }
+    uint32_t shift = WHEEL_BITS * level;
+    uint32_t first = (_wheelTime >> shift) & WHEEL_SLOT_MASK;
+    /* Slot of current digit is pending only at the beginning of its range */
+    if ((_wheelTime & ((1UL << shift) - 1)) != 0) {
+      first++;
+    }
+    uint64_t ahead = (first < 64) ? (bits & (~0ULL << first)) : 0;
+    uint32_t base = (_wheelTime >> (shift + WHEEL_BITS)) << (shift + WHEEL_BITS);
+    uint32_t candidate;
+    if (ahead != 0) {
+      candidate = base + ((uint32_t)__builtin_ctzll(ahead) << shift);
+    } else {
+      /* Next rotation */
+      candidate = base + (1UL << (shift + WHEEL_BITS)) + ((uint32_t)__builtin_ctzll(bits) << shift);
+    }
+    if ((candidate - _wheelTime) < distance) {
+      distance = candidate - _wheelTime;
+      found = true;
+    }
+  }
+  *tick = _wheelTime + distance;
+  return found;
+}
+
+/**
+  * @brief  Cascade slots and run callbacks of software timers expired at time
+  * @note   Interrupts must be disabled, they are restored during callbacks
+  * @param  time: current time
+  * @param  primask: interrupt mask to restore during callbacks
+  * @retval None
+  */
+void TimerWheel::advance(uint32_t time, uint32_t primask)
+{
+  uint32_t tick;
+  Event *list;
+
+  while (nextTick(&tick) && ((int32_t)(tick - time) <= 0)) {
+    _wheelTime = tick;
+    /* Entering a new range of upper levels: dispatch their slot on lower levels */
+    for (uint32_t level = TIMER_WHEEL_LEVELS - 1; level > 0; level--) {
+      uint32_t shift = WHEEL_BITS * level;
+      if ((tick & ((1UL << shift) - 1)) == 0) {
+        detach(level, (tick >> shift) & WHEEL_SLOT_MASK, &list);
+        while (list != NULL) {
+          Event *event = list;
+          unlink(event);
+          insert(event);
+        }
+      }
+    }
+    detach(0, tick & WHEEL_SLOT_MASK, &list);
+    _wheelTime = tick + 1;
+    while (list != NULL) {
+      Event *event = list;
+      callback_t callback = event->callback;
+      void *arg = event->arg;
+      unlink(event);
+      if (event->period != 0) {
+        event->expires += event->period;
+        insert(event);
+      }
+      __set_PRIMASK(primask);
+      callback(arg);
+      __disable_irq();
+    }
+  }
+  /* No slot before time, skip empty ticks */
+  if ((int32_t)(time + 1 - _wheelTime) > 0) {
+    _wheelTime = time + 1;
+  }
+}
+
+/**
+  * @brief  Program the compare register on next deadline
+  * @note   Interrupts must be disabled
+  * @retval None
+  */
+void TimerWheel::program(void)
+{
+  uint32_t deadline = now() + WHEEL_MAX_SLEEP;
+  uint32_t tick;
+
+  if (nextTick(&tick) && ((int32_t)(tick - deadline) < 0)) {
+    deadline = tick;
+  }
+  __HAL_TIM_SET_COMPARE(_timer->getHandle(), TIM_CHANNEL_1, deadline & 0xFFFF);
+  if ((int32_t)(deadline - now()) <= 0) {
+    /* Deadline already reached: compare match is missed, force it */
+    LL_TIM_GenerateEvent_CC1(_instance);
+  }
+}
+
+/**
+  * @brief  Compare match callback of the wheel timer
+  * @param  arg: timer wheel
+  * @retval None
+  */
+void TimerWheel::compareCallback(void *arg)
+{
+  TimerWheel *wheel = (TimerWheel *)arg;
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  wheel->advance(wheel->now(), primask);
+  wheel->program();
+  __set_PRIMASK(primask);
+}
+
+#endif /* HAL_TIM_MODULE_ENABLED && !HAL_TIM_MODULE_ONLY */
@@ -0,0 +1,103 @@
+/*
+  Copyright (c) 2020 STMicroelectronics. All right reserved.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _TIMERWHEEL_H_
+#define _TIMERWHEEL_H_
+
+#include "HardwareTimer.h"
+
+#if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
+
+#ifdef __cplusplus
+
+/* Number of levels of the wheel, each level has 64 slots. Events further
+   than 2^(6 * TIMER_WHEEL_LEVELS) microseconds are rescheduled by the last level */
+#ifndef TIMER_WHEEL_LEVELS
+#define TIMER_WHEEL_LEVELS  4
+#endif
+
+/*
+ * \brief Software timers multiplexed on the channel 1 of a single hardware
+ * timer, with 1 microsecond resolution. Events are stored in a hierarchical
+ * timer wheel: start and cancel are O(1), and the compare register is always
+ * programmed to the next deadline.
+ * Callbacks are called from the timer interrupt.
+ */
+class TimerWheel {
+  public:
+    typedef void (*callback_t)(void *arg);
+
+    /*
+     * \brief Software timer. Allocated by user, it must remain valid while started.
+     */
+    struct Event {
+      Event *next;
+      Event **pprev;  // NULL when not started
+      uint32_t expires;
+      uint32_t period;  // 0 for one-shot
+      callback_t callback;
+      void *arg;
+      uint8_t level;
+      uint8_t slot;
+
+      Event() : next(NULL), pprev(NULL), expires(0), period(0), callback(NULL), arg(NULL), level(0), slot(0) {}
+    };
+
+    TimerWheel(TIM_TypeDef *instance);
+    ~TimerWheel();
+
+    void begin(void);
+    void end(void);
+
+    /*
+     * \brief Start a one-shot (period = 0) or periodic software timer. Restart it if already started.
+     *
+     * \param event Software timer
+     * \param delay First expiration delay (in microseconds)
+     * \param period Period (in microseconds), 0 for one-shot
+     * \param callback Function called upon expiration
+     * \param arg Parameter of callback
+     */
+    void start(Event *event, uint32_t delay, uint32_t period, callback_t callback, void *arg = NULL);
+    void cancel(Event *event);
+    bool isActive(Event *event);
+
+    uint32_t now(void);  // Time base of the wheel (in microseconds)
+
+  private:
+    TIM_TypeDef *_instance;
+    HardwareTimer *_timer;
+    uint32_t _lastTime;   // last time read, extends the 16-bit counter
+    uint32_t _wheelTime;  // next tick to process, previous ones are expired
+    uint64_t _occupied[TIMER_WHEEL_LEVELS];
+    Event *_slots[TIMER_WHEEL_LEVELS][64];
+
+    void insert(Event *event);
+    void unlink(Event *event);
+    void detach(uint32_t level, uint32_t slot, Event **list);
+    bool nextTick(uint32_t *tick);
+    void advance(uint32_t time, uint32_t primask);
+    void program(void);
+    static void compareCallback(void *arg);
+};
+
+#endif /* __cplusplus */
+
+#endif /* HAL_TIM_MODULE_ENABLED && !HAL_TIM_MODULE_ONLY */
+
+#endif /* _TIMERWHEEL_H_ */
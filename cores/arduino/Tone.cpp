@@ -31,10 +31,93 @@ typedef struct {
   int32_t count;
 } timerPinInfo_t;
 
+// Tone generated by a timer channel in output compare toggle mode: no interrupt.
+// Timer is created for the tone and released once the tone is stopped.
+typedef struct {
+  HardwareTimer *timer;       // NULL if timer isn't used for tone
+  PinName pin;
+  uint32_t channel;
+  volatile uint32_t duration; // remaining duration in milliseconds, 0 if endless
+  volatile bool stopped;      // tone ended, timer not yet released
+} timerToneHw_t;
+
 static void timerTonePinInit(PinName p, uint32_t frequency, uint32_t duration);
 static void tonePeriodElapsedCallback(HardwareTimer *HT);
+static void toneTimerUpdate(void);
 static timerPinInfo_t TimerTone_pinInfo = {NC, 0};
+static bool TimerTone_pinActive = false;
 static HardwareTimer *TimerTone = NULL;
+static uint32_t TimerTone_freq = 0;     // TimerTone interrupt frequency in hertz, 0 if stopped
+static uint32_t TimerTone_elapsed = 0;  // milliseconds elapsed since last count of hardware tones, times TimerTone_freq
+static timerToneHw_t TimerTone_hw[TIMER_NUM];
+static volatile uint32_t TimerTone_hwTimed = 0;  // number of hardware tones with a duration
+
+/**
+  * @brief  Stop a hardware tone, output is forced to inactive level
+  * @param  hw : hardware tone
+  * @retval None
+  */
+static void toneHwStop(timerToneHw_t *hw)
+{
+  LL_TIM_OC_SetMode(hw->timer->getHandle()->Instance, LL_TIM_CHANNEL_CH1 << (4 * (hw->channel - 1)),
+                    LL_TIM_OCMODE_FORCED_INACTIVE);
+  hw->timer->pause();
+  hw->stopped = true;
+}
+
+/**
+  * @brief  Release the timer of a stopped hardware tone
+  * @note   Not called from interrupt: tone ended by its duration is released
+  *         by next tone(), noTone() or analogWrite() call
+  * @param  hw : hardware tone
+  * @param  destruct : pin is set as input, otherwise output at inactive level
+  * @retval None
+  */
+static void toneHwRelease(timerToneHw_t *hw, bool destruct)
+{
+  delete hw->timer;
+  hw->timer = NULL;
+  hw->stopped = false;
+  if (destruct) {
+    pin_function(hw->pin, STM_PIN_DATA(STM_MODE_INPUT, GPIO_NOPULL, 0));
+  } else {
+    digital_io_write(get_GPIO_Port(STM_PORT(hw->pin)), STM_LL_GPIO_PIN(hw->pin), 0);
+    pin_function(hw->pin, STM_PIN_DATA(STM_MODE_OUTPUT_PP, GPIO_NOPULL, 0));
+  }
+}
+
+/**
+  * @brief  Release timers of hardware tones ended by their duration
+  * @retval None
+  */
+static void toneHwCollect(void)
+{
+  for (uint32_t i = 0; i < TIMER_NUM; i++) {
+    if ((TimerTone_hw[i].timer != NULL) && TimerTone_hw[i].stopped) {
+      toneHwRelease(&TimerTone_hw[i], false);
+    }
+  }
+}
+
+/**
+  * @brief  Count one millisecond of hardware tones durations
+  * @retval None
+  */
+static void toneHwTick(void)
+{
+  for (uint32_t i = 0; i < TIMER_NUM; i++) {
+    timerToneHw_t *hw = &TimerTone_hw[i];
+    if ((hw->timer != NULL) && (hw->duration != 0)) {
+      if (--hw->duration == 0) {
+        toneHwStop(hw);
+        TimerTone_hwTimed--;
+      }
+    }
+  }
+  if (TimerTone_hwTimed == 0) {
+    toneTimerUpdate();
+  }
+}
 
 /**
   * @brief  Tone Period elapsed callback in non-blocking mode
@@ -44,20 +127,150 @@ static HardwareTimer *TimerTone = NULL;
 static void tonePeriodElapsedCallback(HardwareTimer *HT)
 {
   UNUSED(HT);
-  GPIO_TypeDef *port = get_GPIO_Port(STM_PORT(TimerTone_pinInfo.pin));
 
-  if (port != NULL) {
-    if (TimerTone_pinInfo.count != 0) {
-      if (TimerTone_pinInfo.count > 0) {
-        TimerTone_pinInfo.count--;
+  if (TimerTone_pinActive) {
+    GPIO_TypeDef *port = get_GPIO_Port(STM_PORT(TimerTone_pinInfo.pin));
+
+    if (port != NULL) {
+      if (TimerTone_pinInfo.count != 0) {
+        if (TimerTone_pinInfo.count > 0) {
+          TimerTone_pinInfo.count--;
+        }
+        digital_io_toggle(port, STM_LL_GPIO_PIN(TimerTone_pinInfo.pin));
+      } else {
+        digital_io_write(port, STM_LL_GPIO_PIN(TimerTone_pinInfo.pin), 0);
       }
-      digital_io_toggle(port, STM_LL_GPIO_PIN(TimerTone_pinInfo.pin));
-    } else {
-      digital_io_write(port, STM_LL_GPIO_PIN(TimerTone_pinInfo.pin), 0);
+    }
+  }
+
+  if (TimerTone_hwTimed != 0) {
+    // Exact count: one interrupt lasts 1000 / TimerTone_freq milliseconds
+    TimerTone_elapsed += 1000;
+    while (TimerTone_elapsed >= TimerTone_freq) {
+      TimerTone_elapsed -= TimerTone_freq;
+      toneHwTick();
     }
   }
 }
 
+/**
+  * @brief  TimerTone toggles the pin without timer channel, otherwise it runs
+  *         at 1kHz while hardware tones with a duration are playing
+  * @retval None
+  */
+static void toneTimerUpdate(void)
+{
+  if (TimerTone_pinActive) {
+    // Durations are counted at toggling rate
+    return;
+  }
+  if (TimerTone_hwTimed != 0) {
+    if (TimerTone == NULL) {
+      TimerTone = new HardwareTimer(TIMER_TONE);
+    }
+    if (TimerTone_freq != 1000) {
+      TimerTone_freq = 1000;
+      TimerTone_elapsed = 0;
+      TimerTone->setMode(1, TIMER_OUTPUT_COMPARE, NC);
+      TimerTone->setOverflow(TimerTone_freq, HERTZ_FORMAT);
+      TimerTone->attachInterrupt(tonePeriodElapsedCallback);
+      TimerTone->resume();
+    }
+  } else if (TimerTone != NULL) {
+    TimerTone->pause();
+    TimerTone_freq = 0;
+  }
+}
+
+/**
+  * @brief  Start a tone with timer channel of the pin in output compare toggle mode
+  * @param  p : pin name
+  * @param  frequency : tone frequency (in hertz)
+  * @param  duration : tone duration (in milliseconds), 0 if endless
+  * @retval false if pin has no timer channel available, tone is then generated by TimerTone
+  */
+static bool toneHwInit(PinName p, uint32_t frequency, uint32_t duration)
+{
+  TIM_TypeDef *instance = (TIM_TypeDef *)pinmap_peripheral(p, PinMap_PWM);
+  uint32_t function = pinmap_function(p, PinMap_PWM);
+  timer_index_t index = get_timer_index(instance);
+
+  // Complementary outputs are active when compare output is forced inactive
+  if ((instance == NULL) || (instance == TIMER_TONE) || (index == UNKNOWN_TIMER) ||
+      STM_PIN_INVERTED(function) || (frequency > MAX_FREQ) || (TimerTone_pinInfo.pin == p)) {
+    return false;
+  }
+
+  timerToneHw_t *hw = &TimerTone_hw[index];
+  if (hw->timer == NULL) {
+    if (HardwareTimer_Handle[index] != NULL) {
+      return false;  // timer already used (analogWrite, servo...)
+    }
+    hw->timer = new HardwareTimer(instance);
+  } else if (hw->pin != p) {
+    return false;  // timer already generates a tone on another pin
+  }
+  hw->pin = p;
+  hw->channel = STM_PIN_CHANNEL(function);
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  if (hw->duration != 0) {
+    hw->duration = 0;
+    TimerTone_hwTimed--;
+  }
+  __set_PRIMASK(primask);
+
+  if (frequency == 0) {
+    toneHwStop(hw);
+    toneHwRelease(hw, false);
+  } else {
+    hw->stopped = false;
+    hw->timer->pause();
+    hw->timer->setMode(hw->channel, TIMER_OUTPUT_COMPARE_TOGGLE, p);
+    // Output toggles once per period
+    hw->timer->setOverflow(2 * frequency, HERTZ_FORMAT);
+    hw->timer->setCaptureCompare(hw->channel, 0, TICK_COMPARE_FORMAT);
+    hw->timer->resume();
+    hw->timer->refresh();
+    if (duration > 0) {
+      __disable_irq();
+      hw->duration = duration;
+      TimerTone_hwTimed++;
+      __set_PRIMASK(primask);
+    }
+  }
+  toneTimerUpdate();
+  return true;
+}
+
+/**
+  * @brief  Stop a hardware tone and release its timer
+  * @param  p : pin name
+  * @param  destruct : set pin as input
+  * @retval false if no hardware tone is generated on pin
+  */
+static bool toneHwDeinit(PinName p, bool destruct)
+{
+  for (uint32_t i = 0; i < TIMER_NUM; i++) {
+    timerToneHw_t *hw = &TimerTone_hw[i];
+    if ((hw->timer != NULL) && (hw->pin == p)) {
+      uint32_t primask = __get_PRIMASK();
+      __disable_irq();
+      if (hw->duration != 0) {
+        hw->duration = 0;
+        TimerTone_hwTimed--;
+      }
+      __set_PRIMASK(primask);
+      toneHwStop(hw);
+      toneHwRelease(hw, destruct);
+      toneTimerUpdate();
+      return true;
+    }
+  }
+  return false;
+}
+
 /**
   * @brief  This function will reset the tone timer
   * @param  port : pointer to port
@@ -73,6 +286,8 @@ static void timerTonePinDeinit()
     pin_function(TimerTone_pinInfo.pin, STM_PIN_DATA(STM_MODE_INPUT, GPIO_NOPULL, 0));
     TimerTone_pinInfo.pin = NC;
   }
+  TimerTone_pinActive = false;
+  TimerTone_freq = 0;
 }
 
 static void timerTonePinInit(PinName p, uint32_t frequency, uint32_t duration)
@@ -81,9 +296,12 @@ static void timerTonePinInit(PinName p, uint32_t frequency, uint32_t duration)
 
   if (frequency <= MAX_FREQ) {
     if (frequency == 0) {
+      TimerTone_pinActive = false;
       if (TimerTone != NULL) {
         TimerTone->pause();
+        TimerTone_freq = 0;
       }
+      toneTimerUpdate();
     } else {
       TimerTone_pinInfo.pin = p;
 
@@ -96,6 +314,9 @@ static void timerTonePinInit(PinName p, uint32_t frequency, uint32_t duration)
 
       pin_function(TimerTone_pinInfo.pin, STM_PIN_DATA(STM_MODE_OUTPUT_PP, GPIO_NOPULL, 0));
 
+      TimerTone_freq = timFreq;
+      TimerTone_elapsed = 0;
+      TimerTone_pinActive = true;
       TimerTone->setMode(1, TIMER_OUTPUT_COMPARE, NC);
       TimerTone->setOverflow(timFreq, HERTZ_FORMAT);
       TimerTone->attachInterrupt(tonePeriodElapsedCallback);
@@ -109,11 +330,12 @@ void tone(uint8_t _pin, unsigned int frequency, unsigned long duration)
 {
   PinName p = digitalPinToPinName(_pin);
 
-  if (TimerTone == NULL) {
-    TimerTone = new HardwareTimer(TIMER_TONE);
-  }
+  toneHwCollect();
+  if ((p != NC) && !toneHwInit(p, frequency, duration)) {
+    if (TimerTone == NULL) {
+      TimerTone = new HardwareTimer(TIMER_TONE);
+    }
 
-  if (p != NC) {
     if ((TimerTone_pinInfo.pin == NC) || (TimerTone_pinInfo.pin == p)) {
       timerTonePinInit(p, frequency, duration);
     }
@@ -123,15 +345,33 @@ void tone(uint8_t _pin, unsigned int frequency, unsigned long duration)
 void noTone(uint8_t _pin, bool destruct)
 {
   PinName p = digitalPinToPinName(_pin);
+  if ((p != NC) && toneHwDeinit(p, destruct)) {
+    return;
+  }
   if ((p != NC) && (TimerTone_pinInfo.pin == p) && (TimerTone != NULL)) {
     if (destruct) {
       timerTonePinDeinit();
       delete (TimerTone);
       TimerTone = NULL;
     } else {
+      TimerTone_pinActive = false;
       TimerTone->pause();
+      TimerTone_freq = 0;
     }
+    toneTimerUpdate();
+  }
+  toneHwCollect();
+}
+
+bool isTimerUsedByTone(TIM_TypeDef *tim)
+{
+  timer_index_t index = get_timer_index(tim);
+
+  toneHwCollect();
+  if ((tim == TIMER_TONE) && (TimerTone != NULL)) {
+    return true;
   }
+  return (index != UNKNOWN_TIMER) && (TimerTone_hw[index].timer != NULL);
 }
 #else
 #warning "TIMER_TONE or HAL_TIM_MODULE_ENABLED not defined"
@@ -146,4 +386,12 @@ void noTone(uint8_t _pin)
 {
   UNUSED(_pin);
 }
+
+#if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
+bool isTimerUsedByTone(TIM_TypeDef *tim)
+{
+  UNUSED(tim);
+  return false;
+}
+#endif
 #endif /* HAL_TIM_MODULE_ENABLED && TIMER_TONE && !HAL_TIM_MODULE_ONLY*/
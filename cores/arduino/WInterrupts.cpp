@@ -22,38 +22,43 @@
 #include "PinAF_STM32F1.h"
 #include "interrupt.h"
 
-void attachInterrupt(uint32_t pin, callback_function_t callback, uint32_t mode)
-{
 #if !defined(HAL_EXTI_MODULE_DISABLED)
-  uint32_t it_mode;
-  PinName p = digitalPinToPinName(pin);
-  GPIO_TypeDef *port = set_GPIO_Port_Clock(STM_PORT(p));
-  if (!port) {
-    return;
-  }
-
+static uint32_t get_it_mode(uint32_t mode)
+{
   switch (mode) {
     case CHANGE :
-      it_mode = GPIO_MODE_IT_RISING_FALLING;
-      break;
+      return GPIO_MODE_IT_RISING_FALLING;
     case FALLING :
     case LOW :
-      it_mode = GPIO_MODE_IT_FALLING;
-      break;
+      return GPIO_MODE_IT_FALLING;
     case RISING :
     case HIGH :
-      it_mode = GPIO_MODE_IT_RISING;
-      break;
     default:
-      it_mode = GPIO_MODE_IT_RISING;
-      break;
+      return GPIO_MODE_IT_RISING;
   }
+}
 
+static GPIO_TypeDef *get_it_port(PinName p)
+{
+  GPIO_TypeDef *port = set_GPIO_Port_Clock(STM_PORT(p));
 #ifdef STM32F1xx
-  pinF1_DisconnectDebug(p);
+  if (port) {
+    pinF1_DisconnectDebug(p);
+  }
 #endif /* STM32F1xx */
+  return port;
+}
+#endif
 
-  stm32_interrupt_enable(port, STM_GPIO_PIN(p), callback, it_mode);
+void attachInterrupt(uint32_t pin, callback_function_t callback, uint32_t mode)
+{
+#if !defined(HAL_EXTI_MODULE_DISABLED)
+  PinName p = digitalPinToPinName(pin);
+  GPIO_TypeDef *port = get_it_port(p);
+  if (!port) {
+    return;
+  }
+  stm32_interrupt_enable(port, STM_GPIO_PIN(p), callback, get_it_mode(mode));
 #else
   UNUSED(pin);
   UNUSED(callback);
@@ -61,11 +66,32 @@ void attachInterrupt(uint32_t pin, callback_function_t callback, uint32_t mode)
 #endif
 }
 
+void attachInterrupt(uint32_t pin, void (*callback)(void *), void *arg, uint32_t mode)
+{
+#if !defined(HAL_EXTI_MODULE_DISABLED)
+  PinName p = digitalPinToPinName(pin);
+  GPIO_TypeDef *port = get_it_port(p);
+  if (!port) {
+    return;
+  }
+  stm32_interrupt_enable(port, STM_GPIO_PIN(p), callback, arg, get_it_mode(mode));
+#else
+  UNUSED(pin);
+  UNUSED(callback);
+  UNUSED(arg);
+  UNUSED(mode);
+#endif
+}
+
 void attachInterrupt(uint32_t pin, void (*callback)(void), uint32_t mode)
 {
 #if !defined(HAL_EXTI_MODULE_DISABLED)
-  callback_function_t _c = callback;
-  attachInterrupt(pin, _c, mode);
+  PinName p = digitalPinToPinName(pin);
+  GPIO_TypeDef *port = get_it_port(p);
+  if (!port) {
+    return;
+  }
+  stm32_interrupt_enable(port, STM_GPIO_PIN(p), callback, get_it_mode(mode));
 #else
   UNUSED(pin);
   UNUSED(callback);
@@ -26,6 +26,8 @@
 
 typedef std::function<void(void)> callback_function_t;
 void attachInterrupt(uint32_t pin, callback_function_t callback, uint32_t mode);
+// Callback with a user parameter, ex: object pointer. Lowest latency, no std::function involved
+void attachInterrupt(uint32_t pin, void (*callback)(void *), void *arg, uint32_t mode);
 
 #endif
 
@@ -9,6 +9,7 @@
 #include "backup.h"
 #include "clock.h"
 #include "core_callback.h"
+#include "cycles.h"
 #include "digital_io.h"
 #include "dwt.h"
 #include "hw_config.h"
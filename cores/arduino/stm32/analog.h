@@ -40,6 +40,7 @@
 #define __ANALOG_H
 
 /* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
 #include "stm32_def.h"
 #include "PeripheralPins.h"
 #include "HardwareTimer.h"
@@ -48,12 +49,71 @@
 extern "C" {
 #endif
 
+/* Exported types ------------------------------------------------------------*/
+/* Called with the address and the number of samples of the filled half */
+typedef void (*adc_stream_callback_t)(uint16_t *data, uint32_t length);
+typedef void (*adc_dual_stream_callback_t)(uint32_t *data, uint32_t length);
+typedef void (*adc_watchdog_callback_t)(void);
+typedef void (*dac_stream_callback_t)(uint16_t *data, uint32_t length);
+
+typedef enum {
+  ADC_DUAL_SIMULTANEOUS,  /* Both ADC convert at the same time */
+  ADC_DUAL_INTERLEAVED,   /* Slave ADC converts half a period after the master */
+} adc_dual_mode_t;
+
+/* Exported macro ------------------------------------------------------------*/
+#if defined(ADC2) && defined(ADC_DUALMODE_REGSIMULT) && \
+    (defined(ADC_DMAACCESSMODE_2) || defined(ADC_DMAACCESSMODE_12_10_BITS) || \
+     defined(ADC_DUALMODEDATAFORMAT_32_10_BITS))
+#define ADC_DUAL_MODE_AVAILABLE
+#endif
+
+#if defined(HAL_ADC_MODULE_ENABLED) && !defined(HAL_ADC_MODULE_ONLY) && \
+    defined(ADC_RIGHTBITSHIFT_1)
+#define ADC_OVERSAMPLING_AVAILABLE
+#endif
+
+/* Analog watchdog interrupt is not handled on STM32MP1xx */
+#if defined(HAL_ADC_MODULE_ENABLED) && !defined(HAL_ADC_MODULE_ONLY) && \
+    !defined(STM32MP1xx)
+#define ADC_WATCHDOG_AVAILABLE
+#endif
+
 /* Exported functions ------------------------------------------------------- */
 void dac_write_value(PinName pin, uint32_t value, uint8_t do_init);
 void dac_stop(PinName pin);
+#if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
+bool dac_stream_start(PinName pin, TIM_TypeDef *tim, uint32_t frequency,
+                      uint16_t *buffer, uint32_t length,
+                      dac_stream_callback_t callback);
+void dac_stream_stop(void);
+#endif
 uint16_t adc_read_value(PinName pin, uint32_t resolution);
+#ifdef ADC_OVERSAMPLING_AVAILABLE
+bool adc_set_oversampling(uint32_t ratio, uint32_t shift);
+#endif
+#ifdef ADC_WATCHDOG_AVAILABLE
+bool adc_watchdog_start(PinName pin, uint32_t resolution, uint32_t low,
+                        uint32_t high, adc_watchdog_callback_t callback);
+void adc_watchdog_rearm(void);
+void adc_watchdog_stop(void);
+#endif
+#if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
+bool adc_stream_start(PinName pin, uint32_t resolution, TIM_TypeDef *tim,
+                      uint32_t frequency, uint16_t *buffer, uint32_t length,
+                      adc_stream_callback_t callback);
+#ifdef ADC_DUAL_MODE_AVAILABLE
+bool adc_dual_stream_start(PinName pin, PinName pin2, adc_dual_mode_t mode,
+                           uint32_t resolution, TIM_TypeDef *tim,
+                           uint32_t frequency, uint32_t *buffer, uint32_t length,
+                           adc_dual_stream_callback_t callback);
+#endif
+void adc_stream_stop(void);
+#endif
 #if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
 void pwm_start(PinName pin, uint32_t clock_freq, uint32_t value, TimerCompareFormat_t resolution);
+bool pwm_update(PinName pin, uint32_t value, TimerCompareFormat_t resolution);
+void pwm_cache_clear(void);
 void pwm_stop(PinName pin);
 #endif
 uint32_t get_pwm_channel(PinName pin);
@@ -60,6 +60,14 @@ typedef enum {
 /* Exported functions ------------------------------------------------------- */
 uint32_t getCurrentMillis(void);
 uint32_t getCurrentMicros(void);
+uint64_t getCurrentMillis64(void);
+uint64_t getCurrentMicros64(void);
+uint64_t getCurrentNanos64(void);
+#if defined(TICKLESS_TIMER)
+uint64_t timebaseGetMicros64(void);
+void timebaseSetWakeup(uint32_t us);
+bool timebaseWakeupPending(void);
+#endif
 
 void enableClock(sourceClock_t source);
 #ifdef __cplusplus
@@ -0,0 +1,86 @@
+/**
+  ******************************************************************************
+  * @file    cycles.h
+  * @brief   Core clock cycle counter, used to measure short code sequences
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2020, STMicroelectronics
+  * All rights reserved.
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef _CYCLES_H_
+#define _CYCLES_H_
+
+#include "dwt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+  * @brief  Start the cycle counter: DWT cycle counter, or SysTick on cores
+  *         without DWT (Cortex-M0/M0+). SysTick is started without interrupt
+  *         when it is not running (ex: TICKLESS_TIMER).
+  * @retval None
+  */
+static inline void cycles_init(void)
+{
+#ifdef DWT_BASE
+  dwt_init();
+#else
+  if (!(SysTick->CTRL & SysTick_CTRL_ENABLE_Msk)) {
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+  }
+#endif
+}
+
+/**
+  * @brief  Read the cycle counter
+  * @retval Counter value, to be given to cycles_elapsed()
+  */
+static inline uint32_t cycles_get(void)
+{
+#ifdef DWT_BASE
+  return dwt_getCycles();
+#else
+  return SysTick->VAL;
+#endif
+}
+
+/**
+  * @brief  Core clock cycles elapsed between two cycles_get() values
+  * @note   Without DWT, elapsed time must be less than one SysTick period
+  * @param  start: value read first
+  * @param  end: value read last
+  * @retval Core clock cycles
+  */
+static inline uint32_t cycles_elapsed(uint32_t start, uint32_t end)
+{
+#ifdef DWT_BASE
+  return end - start;
+#else
+  /* SysTick counts down, from core clock or core clock / 8 */
+  uint32_t cycles = (start >= end) ? (start - end) : (start + SysTick->LOAD + 1 - end);
+  if (!(SysTick->CTRL & SysTick_CTRL_CLKSOURCE_Msk)) {
+    cycles *= 8;
+  }
+  return cycles;
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CYCLES_H_ */
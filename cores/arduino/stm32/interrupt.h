@@ -64,6 +64,8 @@
 
 typedef std::function<void(void)> callback_function_t;
 void stm32_interrupt_enable(GPIO_TypeDef *port, uint16_t pin, callback_function_t callback, uint32_t mode);
+// Handler called directly from interrupt with arg, ex: object pointer
+void stm32_interrupt_enable(GPIO_TypeDef *port, uint16_t pin, void (*handler)(void *), void *arg, uint32_t mode);
 #endif
 
 /* Exported functions ------------------------------------------------------- */
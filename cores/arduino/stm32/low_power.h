@@ -58,6 +58,7 @@ void LowPower_init();
 void LowPower_EnableWakeUpPin(uint32_t pin, uint32_t mode);
 void LowPower_EnableWakeUpUart(serial_t *serial, void (*FuncPtr)(void));
 void LowPower_sleep(uint32_t regulator);
+void LowPower_idle(void);
 void LowPower_stop(serial_t *obj);
 void LowPower_standby();
 void LowPower_shutdown();
@@ -43,6 +43,21 @@ typedef struct {
   int function;
 } PinMap;
 
+/*
+ * Index of a PinMap table (ex: PinMap_PWM), so that a lookup only compares the
+ * entries of the pin port. Generated at the end of variant PeripheralPins.c by
+ * CI/utils/gen_pinmap_index.py, in flash. Tables not in PinMap_Index are scanned.
+ * A sketch redefining a PinMap table must also redefine PinMap_Index, ex:
+ * const PinMapIndex PinMap_Index[] = {{NULL, {0}, {0}}};
+ */
+typedef struct {
+  const PinMap *map;
+  uint16_t first[MAX_NB_PORT];  // position of the first entry of each port
+  uint8_t count[MAX_NB_PORT];  // number of entries of each port, 0 if none
+} PinMapIndex;
+
+extern const PinMapIndex PinMap_Index[];  // terminated by a NULL map
+
 bool pin_in_pinmap(PinName pin, const PinMap *map);
 void pin_function(PinName pin, int function);
 
@@ -16,6 +16,7 @@
 #define __TIMER_H
 
 /* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
 #include "stm32_def.h"
 #include "PinNames.h"
 
@@ -258,6 +259,11 @@ uint8_t getTimerClkSrc(TIM_TypeDef *tim);
 
 IRQn_Type getTimerUpIrq(TIM_TypeDef *tim);
 IRQn_Type getTimerCCIrq(TIM_TypeDef *tim);
+bool getTimerUpDma(TIM_TypeDef *tim, DMA_HandleTypeDef *hdma);
+bool getTimerCCDma(TIM_TypeDef *tim, uint32_t channel, DMA_HandleTypeDef *hdma);
+bool acquireDma(DMA_HandleTypeDef *hdma);
+void releaseDma(DMA_HandleTypeDef *hdma);
+bool isTimerUsedByTone(TIM_TypeDef *tim);
 
 #endif /* HAL_TIM_MODULE_ENABLED && !HAL_TIM_MODULE_ONLY */
 
@@ -42,6 +42,10 @@
 
 #ifdef __cplusplus
 #include "HardwareTimer.h"
+#include "PwmPin.h"
+#include "FastPin.h"
+#include "PortBus.h"
+#include "TimerWheel.h"
 #include "Tone.h"
 #include "WCharacter.h"
 #include "WSerial.h"
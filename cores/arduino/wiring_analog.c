@@ -63,6 +63,9 @@ static int _internalReadResolution =
 #endif /* ADC_RESOLUTION > MAX_ADC_RESOLUTION */
   ;
 
+/* Bits added (or removed) by the hardware oversampler */
+static int _oversamplingBits = 0;
+
 static int _writeResolution = PWM_RESOLUTION;
 static int _internalWriteResolution =
 #if PWM_RESOLUTION > MAX_PWM_RESOLUTION
@@ -77,44 +80,66 @@ static uint32_t _writeFreq = PWM_FREQUENCY;
 void analogReadResolution(int res)
 {
   if ((res > 0) && (res <= 32)) {
-    _readResolution = res;
-    _internalReadResolution = _readResolution;
-    if (_readResolution > MAX_ADC_RESOLUTION) {
-      _internalReadResolution = MAX_ADC_RESOLUTION;
+    int internalResolution = res;
+    if (res > MAX_ADC_RESOLUTION) {
+      internalResolution = MAX_ADC_RESOLUTION;
     } else {
 #ifdef ADC_RESOLUTION_12B
 #ifdef ADC_RESOLUTION_6B
-      if (_internalReadResolution <= 6) {
-        _internalReadResolution = 6;
+      if (internalResolution <= 6) {
+        internalResolution = 6;
       } else
 #endif
-        if (_internalReadResolution <= 8) {
-          _internalReadResolution = 8;
-        } else if (_internalReadResolution <= 10) {
-          _internalReadResolution = 10;
-        } else if (_internalReadResolution <= 12) {
-          _internalReadResolution = 12;
+        if (internalResolution <= 8) {
+          internalResolution = 8;
+        } else if (internalResolution <= 10) {
+          internalResolution = 10;
+        } else if (internalResolution <= 12) {
+          internalResolution = 12;
         }
 #ifdef ADC_RESOLUTION_14B
-        else if (_internalReadResolution <= 14) {
-          _internalReadResolution = 14;
+        else if (internalResolution <= 14) {
+          internalResolution = 14;
         }
 #endif
 #ifdef ADC_RESOLUTION_16B
-        else if (_internalReadResolution <= 16) {
-          _internalReadResolution = 16;
+        else if (internalResolution <= 16) {
+          internalResolution = 16;
         }
 #endif
 #else
       /* STM32F1xx have no ADC_RESOLUTION_xB */
-      _internalReadResolution = 12;
+      internalResolution = 12;
 #endif
     }
+    /* Converted data must still fit in 16 bits with the oversampling bits */
+    if ((internalResolution + _oversamplingBits) > 16) {
+      return;
+    }
+    _readResolution = res;
+    _internalReadResolution = internalResolution;
   } else {
     Error_Handler();
   }
 }
 
+#ifdef ADC_OVERSAMPLING_AVAILABLE
+bool analogReadOversampling(uint32_t ratio, uint32_t shift)
+{
+  int bits = 0;
+  while ((bits < 31) && ((1UL << bits) < ratio)) {
+    bits++;
+  }
+  bits -= (ratio > 1) ? (int)shift : 0;
+  /* Converted data must fit in the 16 bits returned by adc_read_value() */
+  if (((_internalReadResolution + bits) > 16) || !adc_set_oversampling(ratio, shift)) {
+    return false;
+  }
+  _oversamplingBits = bits;
+  return true;
+}
+#endif /* ADC_OVERSAMPLING_AVAILABLE */
+
 void analogWriteResolution(int res)
 {
   if ((res > 0) && (res <= 32)) {
@@ -132,6 +157,10 @@ void analogWriteResolution(int res)
 void analogWriteFrequency(uint32_t freq)
 {
   _writeFreq = freq;
+#if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
+  /* Running PWM pins get the new frequency on their next analogWrite() */
+  pwm_cache_clear();
+#endif
 }
 
 static inline uint32_t mapResolution(uint32_t value, uint32_t from, uint32_t to)
@@ -162,7 +191,7 @@ uint32_t analogRead(uint32_t ulPin)
   PinName p = analogInputToPinName(ulPin);
   if (p != NC) {
     value = adc_read_value(p, _internalReadResolution);
-    value = mapResolution(value, _internalReadResolution, _readResolution);
+    value = mapResolution(value, _internalReadResolution + _oversamplingBits, _readResolution);
   }
 #else
   UNUSED(ulPin);
@@ -186,6 +215,13 @@ void analogWrite(uint32_t ulPin, uint32_t ulValue)
 #endif
   PinName p = digitalPinToPinName(ulPin);
   if (p != NC) {
+#if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
+    // Fast path: PWM already running on this pin, only update the duty cycle
+    if (pwm_update(p, mapResolution(ulValue, _writeResolution, _internalWriteResolution),
+                   _internalWriteResolution)) {
+      return;
+    }
+#endif /* HAL_TIM_MODULE_ENABLED && !HAL_TIM_MODULE_ONLY */
 #if defined(HAL_DAC_MODULE_ENABLED) && !defined(HAL_DAC_MODULE_ONLY)
     if (pin_in_pinmap(p, PinMap_DAC)) {
       if (is_pin_configured(p, g_anOutputPinConfigured) == false) {
@@ -19,6 +19,8 @@
 #ifndef _WIRING_ANALOG_
 #define _WIRING_ANALOG_
 
+#include "analog.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -59,10 +61,28 @@ extern uint32_t analogRead(uint32_t ulPin) ;
 /*
  * \brief Set the resolution of analogRead return values. Default is 10 bits (range from 0 to 1023).
  *
+ * Resolution is unchanged when the ADC resolution used for it, with the bits
+ * of analogReadOversampling(), would not fit in 16 bits.
+ *
  * \param res
  */
 extern void analogReadResolution(int res);
 
+/*
+ * \brief Enable the ADC hardware oversampler for analogRead.
+ * The sum of ratio conversions is right shifted by shift bits, each extra bit
+ * not shifted out is added to the resolution of the converted value.
+ * Only available on series with an ADC hardware oversampler (L0, L4, G0, G4, H7, WB),
+ * when ADC_OVERSAMPLING_AVAILABLE is defined.
+ *
+ * \param ratio power of 2 number of conversions, 1 disables the oversampler
+ * \param shift right bit shift applied to the sum
+ * \return false if settings are not supported, analogRead is then unchanged
+ */
+#ifdef ADC_OVERSAMPLING_AVAILABLE
+extern bool analogReadOversampling(uint32_t ratio, uint32_t shift);
+#endif
+
 /*
  * \brief Set the resolution of analogWrite parameters. Default is 8 bits (range from 0 to 255).
  *
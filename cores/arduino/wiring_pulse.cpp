@@ -72,3 +72,126 @@ uint32_t pulseInLong(uint32_t pin, uint32_t state, uint32_t timeout)
 {
   return pulseIn(pin, state, timeout);
 }
+
+#if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
+/* Edge timestamps captured by pulseInTimer(), in timer ticks of 1 microsecond */
+typedef struct {
+  TIM_TypeDef *instance;
+  uint32_t channel;
+  uint32_t state;
+  volatile uint32_t phase;    // 0: wait previous pulse end, 1: wait pulse start, 2: wait pulse end, 3: done
+  volatile uint32_t overflows;
+  uint32_t start;
+  uint32_t end;
+} pulse_capture_t;
+
+static pulse_capture_t pulseCapture;
+
+static const uint32_t pulseCaptureLLChannel[TIMER_CHANNELS] = {
+  LL_TIM_CHANNEL_CH1, LL_TIM_CHANNEL_CH2, LL_TIM_CHANNEL_CH3, LL_TIM_CHANNEL_CH4
+};
+
+static void pulseCaptureSetEdge(uint32_t level)
+{
+  LL_TIM_IC_SetPolarity(pulseCapture.instance, pulseCaptureLLChannel[pulseCapture.channel - 1],
+                        (level == LOW) ? LL_TIM_IC_POLARITY_FALLING : LL_TIM_IC_POLARITY_RISING);
+}
+
+static void pulseCaptureOverflow(HardwareTimer *HT)
+{
+  UNUSED(HT);
+  pulseCapture.overflows++;
+}
+
+static void pulseCaptureEdge(HardwareTimer *HT)
+{
+  uint32_t ccr = HT->getCaptureCompare(pulseCapture.channel);
+  uint32_t overflows = pulseCapture.overflows;
+  // Rollover not yet accounted: capture occurred after it
+  if (__HAL_TIM_GET_FLAG(HT->getHandle(), TIM_FLAG_UPDATE) && (ccr < 0x8000)) {
+    overflows++;
+  }
+  uint32_t ticks = (overflows << 16) | ccr;
+
+  switch (pulseCapture.phase) {
+    case 0:
+      pulseCaptureSetEdge(pulseCapture.state);
+      pulseCapture.phase = 1;
+      break;
+    case 1:
+      pulseCapture.start = ticks;
+      pulseCaptureSetEdge(!pulseCapture.state);
+      pulseCapture.phase = 2;
+      break;
+    case 2:
+      pulseCapture.end = ticks;
+      pulseCapture.phase = 3;
+      break;
+    default:
+      break;
+  }
+}
+#endif /* HAL_TIM_MODULE_ENABLED && !HAL_TIM_MODULE_ONLY */
+
+/* Measures the length (in microseconds) of a pulse on the pin like pulseIn(),
+ * but edges are timestamped by the input capture of the timer connected to the
+ * pin, and the core sleeps (WFI) while waiting instead of polling.
+ * Falls back to pulseIn() if the pin has no timer channel, or if its timer is
+ * already in use.
+ *
+ * ATTENTION:
+ * The pin is left in INPUT mode. Pulses shorter than the capture interrupt
+ * latency (about 1-2 microseconds) are missed.
+ */
+uint32_t pulseInTimer(uint32_t pin, uint32_t state, uint32_t timeout)
+{
+#if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
+  PinName p = digitalPinToPinName(pin);
+  TIM_TypeDef *Instance = (TIM_TypeDef *)pinmap_peripheral(p, PinMap_PWM);
+  if ((p == NC) || (Instance == NP) || STM_PIN_INVERTED(pinmap_function(p, PinMap_PWM)) ||
+      (HardwareTimer_Handle[get_timer_index(Instance)] != NULL)) {
+    return pulseIn(pin, state, timeout);
+  }
+
+  uint32_t bit = digitalPinToBitMask(pin);
+  __IO uint32_t *portIn = portInputRegister(digitalPinToPort(pin));
+  uint32_t result = 0;
+  HardwareTimer *HT = new HardwareTimer(Instance);
+
+  pulseCapture.instance = Instance;
+  pulseCapture.channel = STM_PIN_CHANNEL(pinmap_function(p, PinMap_PWM));
+  pulseCapture.state = state;
+  pulseCapture.overflows = 0;
+  HT->setPrescaleFactor(HT->getTimerClkFreq() / 1000000);
+  HT->setOverflow(0x10000);
+  HT->setMode(pulseCapture.channel, TIMER_INPUT_CAPTURE_RISING, p);
+  HT->attachInterrupt(pulseCaptureOverflow);
+  HT->attachInterrupt(pulseCapture.channel, pulseCaptureEdge);
+
+  // Wait for any previous pulse to end if the pin is already at state level
+  pulseCapture.phase = (((*portIn & bit) != 0) == (state != LOW)) ? 0 : 1;
+  pulseCaptureSetEdge((pulseCapture.phase == 0) ? !state : state);
+
+  // Load prescaler now, update flag raised by this event is cleared by resume()
+  HT->refresh();
+  uint32_t startMicros = micros();
+  HT->resume();
+  while (pulseCapture.phase != 3) {
+    if (micros() - startMicros > timeout) {
+      break;
+    }
+    // Woken up by capture, rollover or SysTick interrupt
+    __WFI();
+  }
+  if (pulseCapture.phase == 3) {
+    result = pulseCapture.end - pulseCapture.start;
+  }
+
+  HT->pause();
+  delete HT;
+  pinMode(pin, INPUT);
+  return result;
+#else
+  return pulseIn(pin, state, timeout);
+#endif /* HAL_TIM_MODULE_ENABLED && !HAL_TIM_MODULE_ONLY */
+}
@@ -28,6 +28,13 @@
  */
 extern uint32_t pulseIn(uint32_t pin, uint32_t state, uint32_t timeout = 1000000L) ;
 extern uint32_t pulseInLong(uint32_t pin, uint32_t state, uint32_t timeout = 1000000L) ;
+
+/*
+ * \brief Measures the length (in microseconds) of a pulse on the pin like pulseIn(),
+ * using the input capture of the timer connected to the pin, without polling.
+ * Falls back to pulseIn() if no timer is available for the pin.
+ */
+extern uint32_t pulseInTimer(uint32_t pin, uint32_t state, uint32_t timeout = 1000000L) ;
 #endif
 
 #endif /* _WIRING_PULSE_ */
@@ -22,21 +22,81 @@
 extern "C" {
 #endif
 
+/*
+ * Clock pins are driven through their port registers, resolved once per call.
+ * Clock high and low times are at least SHIFT_CLOCK_HALF_PERIOD_NS so that
+ * slow shift registers (ex: 74HC595 at low voltage) can follow on fast cores.
+ */
+#ifndef SHIFT_CLOCK_HALF_PERIOD_NS
+#define SHIFT_CLOCK_HALF_PERIOD_NS  50
+#endif
+
+typedef struct {
+  GPIO_TypeDef *dataPort;
+  uint32_t dataPin;   /* LL pin mask */
+  GPIO_TypeDef *clockPort;
+  uint32_t clockPin;  /* LL pin mask */
+  uint32_t wait;      /* core clock cycles of half clock period */
+} shift_pins_t;
+
+static bool shift_get_pins(uint32_t ulDataPin, uint32_t ulClockPin, shift_pins_t *pins)
+{
+  PinName data = digitalPinToPinName(ulDataPin);
+  PinName clock = digitalPinToPinName(ulClockPin);
+
+  if ((data == NC) || (clock == NC)) {
+    return false;
+  }
+  pins->dataPort = get_GPIO_Port(STM_PORT(data));
+  pins->dataPin = STM_LL_GPIO_PIN(data);
+  pins->clockPort = get_GPIO_Port(STM_PORT(clock));
+  pins->clockPin = STM_LL_GPIO_PIN(clock);
+  /* Rounded up: clock high and low times must not be shorter */
+  pins->wait = ((SystemCoreClock / 1000000U) * SHIFT_CLOCK_HALF_PERIOD_NS + 999U) / 1000U;
+  return ((pins->dataPort != NULL) && (pins->clockPort != NULL));
+}
+
+static inline void shift_wait(uint32_t cycles)
+{
+  /* Cycle counted, whatever the number of cycles of a loop iteration */
+  delayCycles(cycles);
+}
+
+static void shift_out_byte(const shift_pins_t *pins, uint32_t ulBitOrder, uint8_t val)
+{
+  for (uint32_t i = 0 ; i < 8 ; i++) {
+    if (val & ((ulBitOrder == LSBFIRST) ? (1 << i) : (1 << (7 - i)))) {
+      LL_GPIO_SetOutputPin(pins->dataPort, pins->dataPin);
+    } else {
+      LL_GPIO_ResetOutputPin(pins->dataPort, pins->dataPin);
+    }
+    shift_wait(pins->wait);
+    LL_GPIO_SetOutputPin(pins->clockPort, pins->clockPin);
+    shift_wait(pins->wait);
+    LL_GPIO_ResetOutputPin(pins->clockPort, pins->clockPin);
+  }
+}
+
 uint32_t shiftIn(uint32_t ulDataPin, uint32_t ulClockPin, uint32_t ulBitOrder)
 {
+  shift_pins_t pins;
   uint8_t value = 0 ;
   uint8_t i ;
 
+  if (!shift_get_pins(ulDataPin, ulClockPin, &pins)) {
+    return 0;
+  }
+
   for (i = 0 ; i < 8 ; ++i) {
-    digitalWrite(ulClockPin, HIGH) ;
+    LL_GPIO_SetOutputPin(pins.clockPort, pins.clockPin);
+    shift_wait(pins.wait);
 
-    if (ulBitOrder == LSBFIRST) {
-      value |= digitalRead(ulDataPin) << i ;
-    } else {
-      value |= digitalRead(ulDataPin) << (7 - i) ;
+    if (LL_GPIO_IsInputPinSet(pins.dataPort, pins.dataPin)) {
+      value |= (ulBitOrder == LSBFIRST) ? (1 << i) : (1 << (7 - i));
     }
 
-    digitalWrite(ulClockPin, LOW) ;
+    LL_GPIO_ResetOutputPin(pins.clockPort, pins.clockPin);
+    shift_wait(pins.wait);
   }
 
   return value ;
@@ -44,17 +104,21 @@ uint32_t shiftIn(uint32_t ulDataPin, uint32_t ulClockPin, uint32_t ulBitOrder)
 
 void shiftOut(uint32_t ulDataPin, uint32_t ulClockPin, uint32_t ulBitOrder, uint32_t ulVal)
 {
-  uint8_t i ;
+  shift_pins_t pins;
 
-  for (i = 0 ; i < 8 ; i++) {
-    if (ulBitOrder == LSBFIRST) {
-      digitalWrite(ulDataPin, !!(ulVal & (1 << i))) ;
-    } else {
-      digitalWrite(ulDataPin, !!(ulVal & (1 << (7 - i)))) ;
-    }
+  if (shift_get_pins(ulDataPin, ulClockPin, &pins)) {
+    shift_out_byte(&pins, ulBitOrder, (uint8_t)ulVal);
+  }
+}
 
-    digitalWrite(ulClockPin, HIGH) ;
-    digitalWrite(ulClockPin, LOW) ;
+void shiftOutBuffer(uint32_t ulDataPin, uint32_t ulClockPin, uint32_t ulBitOrder, const uint8_t *buf, size_t len)
+{
+  shift_pins_t pins;
+
+  if ((buf != NULL) && shift_get_pins(ulDataPin, ulClockPin, &pins)) {
+    while (len--) {
+      shift_out_byte(&pins, ulBitOrder, *buf++);
+    }
   }
 }
 
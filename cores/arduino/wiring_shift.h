@@ -34,9 +34,19 @@ extern uint32_t shiftIn(uint32_t ulDataPin, uint32_t ulClockPin, uint32_t ulBitO
  */
 extern void shiftOut(uint32_t ulDataPin, uint32_t ulClockPin, uint32_t ulBitOrder, uint32_t ulVal) ;
 
+/*
+ * \brief Shift out len bytes of buf, pins are resolved once for the whole buffer
+ */
+extern void shiftOutBuffer(uint32_t ulDataPin, uint32_t ulClockPin, uint32_t ulBitOrder, const uint8_t *buf, size_t len) ;
+
 
 #ifdef __cplusplus
 }
+
+inline void shiftOut(uint32_t ulDataPin, uint32_t ulClockPin, uint32_t ulBitOrder, const uint8_t *buf, size_t len)
+{
+  shiftOutBuffer(ulDataPin, ulClockPin, ulBitOrder, buf, len);
+}
 #endif
 
 #endif /* _WIRING_SHIFT_ */
@@ -34,16 +34,145 @@ uint32_t micros(void)
   return getCurrentMicros();
 }
 
+uint64_t millis64(void)
+{
+  return getCurrentMillis64();
+}
+
+uint64_t micros64(void)
+{
+  return getCurrentMicros64();
+}
+
+uint64_t nanos64(void)
+{
+  return getCurrentNanos64();
+}
+
+#if defined(DELAY_LOW_POWER)
+#if defined(STM32L0xx)
+#define DELAY_TICK_PERIOD_MS  1U
+#else
+/* Milliseconds per SysTick interrupt, can be increased with HAL_SetTickFreq() */
+#define DELAY_TICK_PERIOD_MS  ((uint32_t)HAL_GetTickFreq())
+#endif
+
+/*
+ * Sleep until next interrupt if delay is not elapsed. Core is woken up at
+ * least every tick (every millisecond in tickless mode), so that yield() is
+ * still called regularly, and any other interrupt is served without delay.
+ * Time is read before interrupts are disabled, they are only disabled
+ * around WFI when needed.
+ */
+static void delay_sleep(uint32_t start, uint32_t ms)
+{
+  if (__get_PRIMASK() != 0) {
+    /* Interrupts disabled by caller: tick could not wake up the core */
+    return;
+  }
+  uint32_t elapsed = getCurrentMillis() - start;
+  if (elapsed >= ms) {
+    return;
+  }
+#if defined(TICKLESS_TIMER)
+  /* Wake up at next millisecond boundary, which is not after the deadline */
+  timebaseSetWakeup(1000 - (uint32_t)(getCurrentMicros64() % 1000));
+  /* Wake up interrupt occurring after the check below still wakes up WFI */
+  __disable_irq();
+  if (timebaseWakeupPending()) {
+#if defined(HAL_PWR_MODULE_ENABLED) && !defined(HAL_PWR_MODULE_ONLY)
+    LowPower_idle();
+#else
+    __WFI();
+#endif
+  }
+  __enable_irq();
+#else
+  /*
+   * Next tick is at most one period away and must not come after the
+   * deadline, otherwise keep polling. Milliseconds only change on ticks
+   * with a 1 ms period, elapsed time may be up to 1 ms more than read with
+   * a longer one. An interrupt served before WFI does not matter: ticks
+   * keep coming.
+   */
+  uint32_t period = DELAY_TICK_PERIOD_MS;
+  if ((ms - elapsed) >= ((period == 1) ? 1 : (period + 1))) {
+#if defined(HAL_PWR_MODULE_ENABLED) && !defined(HAL_PWR_MODULE_ONLY)
+    LowPower_idle();
+#else
+    __WFI();
+#endif
+  }
+#endif /* TICKLESS_TIMER */
+}
+#endif /* DELAY_LOW_POWER */
+
 void delay(uint32_t ms)
 {
   if (ms != 0) {
     uint32_t start = getCurrentMillis();
     do {
       yield();
+#if defined(DELAY_LOW_POWER)
+      delay_sleep(start, ms);
+#endif
     } while (getCurrentMillis() - start < ms);
   }
 }
 
+#if !defined(DWT_BASE) || defined(DWT_DELAY_DISABLED)
+uint32_t delayLoopPerCycle = 0;
+/* Core clock used for the measure, flash wait states depend on it */
+uint32_t delayLoopClock = 0;
+
+#if defined(TICKLESS_TIMER)
+/* SysTick is not running: iterations are measured with the time base, in
+   microseconds, long enough for a fine result */
+#define DELAY_LOOP_CALIBRATION  16384
+#else
+/* Number of iterations measured, must last less than one SysTick period */
+#define DELAY_LOOP_CALIBRATION  64
+#endif
+
+/* Iteration duration depends on code generation and flash wait states: it is measured */
+void __attribute__((noinline)) delayLoop(uint32_t loops)
+{
+  while (loops--) {
+    __asm volatile("");
+  }
+}
+
+void delayLoopCalibrate(void)
+{
+#if defined(TICKLESS_TIMER)
+  uint64_t start = getCurrentMicros64();
+  delayLoop(DELAY_LOOP_CALIBRATION);
+  uint64_t us = getCurrentMicros64() - start;
+  uint32_t cycles = (uint32_t)((us * SystemCoreClock) / 1000000);
+#else
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  uint32_t period = SysTick->LOAD + 1;
+  uint32_t start = SysTick->VAL;
+  delayLoop(DELAY_LOOP_CALIBRATION);
+  uint32_t end = SysTick->VAL;
+  __set_PRIMASK(primask);
+
+  /* SysTick counts down */
+  uint32_t cycles = (start >= end) ? start - end : start + period - end;
+  if (!(SysTick->CTRL & SysTick_CTRL_CLKSOURCE_Msk)) {
+    cycles *= 8;
+  }
+#endif
+  if (cycles == 0) {
+    cycles = DELAY_LOOP_CALIBRATION * 4;
+  }
+  delayLoopPerCycle = (DELAY_LOOP_CALIBRATION << 16) / cycles;
+  delayLoopClock = SystemCoreClock;
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
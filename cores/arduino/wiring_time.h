@@ -47,6 +47,28 @@ extern uint32_t millis(void) ;
  */
 extern uint32_t micros(void) ;
 
+/**
+ * \brief Returns the number of milliseconds since the program started, on 64 bits so it never overflows.
+ *
+ * Can be called from any interrupt priority, consecutive values never decrease.
+ */
+extern uint64_t millis64(void) ;
+
+/**
+ * \brief Returns the number of microseconds since the program started, on 64 bits so it never overflows.
+ *
+ * micros() returns the lower 32 bits of this value. Can be called from any interrupt priority,
+ * consecutive values never decrease.
+ */
+extern uint64_t micros64(void) ;
+
+/**
+ * \brief Returns the number of nanoseconds since the program started, on 64 bits.
+ *
+ * Resolution is one SysTick clock (HCLK or HCLK/8 depending on the series).
+ */
+extern uint64_t nanos64(void) ;
+
 /**
  * \brief Pauses the program for the amount of time (in miliseconds) specified as parameter.
  * (There are 1000 milliseconds in a second.)
@@ -55,6 +77,55 @@ extern uint32_t micros(void) ;
  */
 extern void delay(uint32_t ms) ;
 
+#if defined(DWT_BASE) && !defined(DWT_DELAY_DISABLED)
+/* Cycles spent reading the cycle counter and checking the delay */
+#ifndef DELAY_CYCLES_OVERHEAD
+#define DELAY_CYCLES_OVERHEAD 8
+#endif
+#else
+/* Cycles spent converting the delay to a loop count and calling delayLoop() */
+#ifndef DELAY_CYCLES_OVERHEAD
+#define DELAY_CYCLES_OVERHEAD 24
+#endif
+/* Loop iterations per core cycle (16-bit fraction), measured at delayLoopClock */
+extern uint32_t delayLoopPerCycle;
+extern uint32_t delayLoopClock;
+extern void delayLoopCalibrate(void);
+extern void delayLoop(uint32_t loops);
+#endif
+
+/**
+ * \brief Pauses the program for the number of core clock cycles specified as parameter.
+ *
+ * Uses the DWT cycle counter when available, else a loop calibrated once
+ * against SysTick (the time base timer in tickless mode). Call overhead is
+ * deducted. Interrupts lengthen the delay.
+ *
+ * \param cycles the number of core clock cycles to pause (uint32_t)
+ */
+static inline void delayCycles(uint32_t) __attribute__((always_inline, unused));
+static inline void delayCycles(uint32_t cycles)
+{
+#if defined(DWT_BASE) && !defined(DWT_DELAY_DISABLED)
+  uint32_t start = dwt_getCycles();
+  cycles = (cycles > DELAY_CYCLES_OVERHEAD) ? cycles - DELAY_CYCLES_OVERHEAD : 0;
+
+  while ((dwt_getCycles() - start) < cycles);
+#else
+  if (delayLoopClock != SystemCoreClock) {
+    delayLoopCalibrate();
+  }
+  /* Split long delays so that the loop count computation does not overflow */
+  while (cycles > 0xFFFF) {
+    delayLoop((0xFFFF * delayLoopPerCycle) >> 16);
+    cycles -= 0xFFFF;
+  }
+  if (cycles > DELAY_CYCLES_OVERHEAD) {
+    delayLoop(((cycles - DELAY_CYCLES_OVERHEAD) * delayLoopPerCycle) >> 16);
+  }
+#endif
+}
+
 /**
  * \brief Pauses the program for the amount of time (in microseconds) specified as parameter.
  *
@@ -63,27 +134,20 @@ extern void delay(uint32_t ms) ;
 static inline void delayMicroseconds(uint32_t) __attribute__((always_inline, unused));
 static inline void delayMicroseconds(uint32_t us)
 {
-#if defined(DWT_BASE) && !defined(DWT_DELAY_DISABLED)
-  int32_t start  = dwt_getCycles();
-  int32_t cycles = us * (SystemCoreClock / 1000000);
+  delayCycles(us * (SystemCoreClock / 1000000));
+}
 
-  while ((int32_t)dwt_getCycles() - start < cycles);
-#else
-  __IO uint32_t currentTicks = SysTick->VAL;
-  /* Number of ticks per millisecond */
-  const uint32_t tickPerMs = SysTick->LOAD + 1;
-  /* Number of ticks to count */
-  const uint32_t nbTicks = ((us - ((us > 0) ? 1 : 0)) * tickPerMs) / 1000;
-  /* Number of elapsed ticks */
-  uint32_t elapsedTicks = 0;
-  __IO uint32_t oldTicks = currentTicks;
-  do {
-    currentTicks = SysTick->VAL;
-    elapsedTicks += (oldTicks < currentTicks) ? tickPerMs + oldTicks - currentTicks :
-                    oldTicks - currentTicks;
-    oldTicks = currentTicks;
-  } while (nbTicks > elapsedTicks);
-#endif
+/**
+ * \brief Pauses the program for the amount of time (in nanoseconds) specified as parameter.
+ *
+ * Resolution is one core clock cycle, for delays up to a few milliseconds.
+ *
+ * \param ns the number of nanoseconds to pause (uint32_t)
+ */
+static inline void delayNanoseconds(uint32_t) __attribute__((always_inline, unused));
+static inline void delayNanoseconds(uint32_t ns)
+{
+  delayCycles((ns * (SystemCoreClock / 1000000)) / 1000);
 }
 
 #ifdef __cplusplus
@@ -31,6 +31,21 @@ static HardwareTimer TimerServo(TIMER_SERVO);
 
 uint8_t ServoCount = 0;                                    // the total number of attached servos
 
+// Servos attached on a PWM pin are driven by the timer channel output instead
+// of the interrupt. Timers are shared by servos on different channels.
+#ifndef SERVO_PWM_REFRESH_INTERVAL
+#define SERVO_PWM_REFRESH_INTERVAL REFRESH_INTERVAL       // PWM period in microseconds, can be lowered for digital servos
+#endif
+
+typedef struct {
+  HardwareTimer *timer;   // NULL if servo is driven by interrupt
+  uint8_t channel;
+} servo_pwm_t;
+
+static servo_pwm_t servoPwm[MAX_SERVOS];
+static HardwareTimer *servoPwmTimers[TIMER_NUM];           // timers created for servos
+static uint8_t servoPwmTimerUsers[TIMER_NUM];              // number of servos attached on each of them
+
 #define SERVO_MIN() (MIN_PULSE_WIDTH - this->min * 4)   // minimum value in uS for this servo
 #define SERVO_MAX() (MAX_PULSE_WIDTH - this->max * 4)   // maximum value in uS for this servo
 
@@ -50,12 +65,16 @@ static void Servo_PeriodElapsedCallback(HardwareTimer *HT)
     // Restart from 1st servo
     CumulativeCountSinceRefresh = 0;
   } else {
-    if (timerChannel[timer_id] < ServoCount && servos[timerChannel[timer_id]].Pin.isActive == true) {
+    if (timerChannel[timer_id] < ServoCount && servos[timerChannel[timer_id]].Pin.isActive == true &&
+        servoPwm[timerChannel[timer_id]].timer == NULL) {
       digitalWrite(servos[timerChannel[timer_id]].Pin.nbr, LOW); // pulse this channel low if activated
     }
   }
 
   timerChannel[timer_id]++;    // increment to the next channel
+  while (timerChannel[timer_id] < ServoCount && servoPwm[timerChannel[timer_id]].timer != NULL) {
+    timerChannel[timer_id]++;  // skip servos driven by PWM
+  }
   if (timerChannel[timer_id] < ServoCount && timerChannel[timer_id] < SERVOS_PER_TIMER) {
     TimerServo.setOverflow(servos[timerChannel[timer_id]].ticks);
     CumulativeCountSinceRefresh += servos[timerChannel[timer_id]].ticks;
@@ -93,13 +112,69 @@ static bool isTimerActive()
 {
   // returns true if any servo is active on this timer
   for (uint8_t channel = 0; channel < SERVOS_PER_TIMER; channel++) {
-    if (servos[channel].Pin.isActive == true) {
+    if (servos[channel].Pin.isActive == true && servoPwm[channel].timer == NULL) {
       return true;
     }
   }
   return false;
 }
 
+static bool ServoPwmAttach(uint8_t servoIndex, int pin)
+{
+  // returns true if servo pin is driven by a timer channel output
+  PinName p = digitalPinToPinName(pin);
+  if (!pin_in_pinmap(p, PinMap_PWM)) {
+    return false;
+  }
+  TIM_TypeDef *instance = (TIM_TypeDef *)pinmap_peripheral(p, PinMap_PWM);
+  uint8_t channel = STM_PIN_CHANNEL(pinmap_function(p, PinMap_PWM));
+  timer_index_t index = get_timer_index(instance);
+  if ((instance == TIMER_SERVO) || (index == UNKNOWN_TIMER)) {
+    return false;
+  }
+
+  HardwareTimer *HT = servoPwmTimers[index];
+  if (HT == NULL) {
+    if (HardwareTimer_Handle[index] != NULL) {
+      return false;  // timer already used by something else (analogWrite, tone...)
+    }
+    // prescaler is computed so that timer tick correspond to 1 microseconde
+    HT = new HardwareTimer(instance);
+    HT->setPrescaleFactor(HT->getTimerClkFreq() / 1000000);
+    HT->setOverflow(SERVO_PWM_REFRESH_INTERVAL);
+    servoPwmTimers[index] = HT;
+  } else {
+    for (uint8_t i = 0; i < ServoCount; i++) {
+      if ((servoPwm[i].timer == HT) && (servoPwm[i].channel == channel) && servos[i].Pin.isActive) {
+        return false;  // channel already used by another servo
+      }
+    }
+  }
+  servoPwmTimerUsers[index]++;
+  servoPwm[servoIndex].timer = HT;
+  servoPwm[servoIndex].channel = channel;
+
+  HT->setMode(channel, TIMER_OUTPUT_COMPARE_PWM1, p);
+  HT->setCaptureCompare(channel, servos[servoIndex].ticks, TICK_COMPARE_FORMAT);
+  HT->resumeChannel(channel);
+  return true;
+}
+
+static void ServoPwmDetach(uint8_t servoIndex)
+{
+  HardwareTimer *HT = servoPwm[servoIndex].timer;
+  timer_index_t index = get_timer_index(HT->getHandle()->Instance);
+
+  HT->pauseChannel(servoPwm[servoIndex].channel);
+  pinMode(servos[servoIndex].Pin.nbr, OUTPUT);
+  digitalWrite(servos[servoIndex].Pin.nbr, LOW);
+  servoPwm[servoIndex].timer = NULL;
+  if (--servoPwmTimerUsers[index] == 0) {
+    delete HT;
+    servoPwmTimers[index] = NULL;
+  }
+}
+
 /****************** end of static functions ******************************/
 
 Servo::Servo()
@@ -120,15 +195,21 @@ uint8_t Servo::attach(int pin)
 uint8_t Servo::attach(int pin, int min, int max)
 {
   if (this->servoIndex < MAX_SERVOS) {
-    pinMode(pin, OUTPUT);                                   // set servo pin to output
+    if (servos[this->servoIndex].Pin.isActive == true) {
+      detach();
+    }
     servos[this->servoIndex].Pin.nbr = pin;
     servos[this->servoIndex].ticks = DEFAULT_PULSE_WIDTH;
     // todo min/max check: abs(min - MIN_PULSE_WIDTH) /4 < 128
     this->min  = (MIN_PULSE_WIDTH - min) / 4; //resolution of min/max is 4 uS
     this->max  = (MAX_PULSE_WIDTH - max) / 4;
-    // initialize the timer if it has not already been initialized
-    if (isTimerActive() == false) {
-      TimerServoInit();
+    if (ServoPwmAttach(this->servoIndex, pin) == false) {
+      // fallback: pin is pulsed by TIMER_SERVO interrupt
+      pinMode(pin, OUTPUT);                                   // set servo pin to output
+      // initialize the timer if it has not already been initialized
+      if (isTimerActive() == false) {
+        TimerServoInit();
+      }
     }
     servos[this->servoIndex].Pin.isActive = true;  // this must be set after the check for isTimerActive
   }
@@ -137,6 +218,14 @@ uint8_t Servo::attach(int pin, int min, int max)
 
 void Servo::detach()
 {
+  if (this->servoIndex >= MAX_SERVOS) {
+    return;
+  }
+  if (servoPwm[this->servoIndex].timer != NULL) {
+    servos[this->servoIndex].Pin.isActive = false;
+    ServoPwmDetach(this->servoIndex);
+    return;
+  }
   servos[this->servoIndex].Pin.isActive = false;
 
   if (isTimerActive() == false) {
@@ -171,6 +260,10 @@ void Servo::writeMicroseconds(int value)
     }
 
     servos[channel].ticks = value;
+    if (servoPwm[channel].timer != NULL) {
+      // compare register is preloaded: pulse width changes at the beginning of next period
+      servoPwm[channel].timer->setCaptureCompare(servoPwm[channel].channel, value, TICK_COMPARE_FORMAT);
+    }
   }
 }
 
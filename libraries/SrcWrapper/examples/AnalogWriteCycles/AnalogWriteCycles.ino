@@ -0,0 +1,81 @@
+/*
+  AnalogWriteCycles
+
+  This example code is in the public domain.
+
+  Measures the number of core clock cycles of analogWrite() and of the PinMap
+  lookups it does, and prints them on Serial. Lookups use the PinMap_Index
+  of the variant, a linear scan of the same table is measured to compare.
+
+  Cycles are counted with the core cycle counter (cycles.h): DWT, or SysTick
+  on Cortex-M0/M0+ which have no DWT. Measures are done with interrupts
+  disabled.
+
+  BENCH_PIN (PA5, the LED of most Nucleo-64 boards) must have a PWM channel.
+*/
+
+#ifndef BENCH_PIN
+#define BENCH_PIN PA_5
+#endif
+
+static uint32_t benchDigitalPin;
+static uint32_t value = 0;
+
+// Lookup without index
+static void *scanPeripheral(PinName pin, const PinMap *map) {
+  for (; map->pin != NC; map++) {
+    if (map->pin == pin) {
+      return map->peripheral;
+    }
+  }
+  return NP;
+}
+
+// Run the statement once and return the number of cycles
+#define MEASURE(statement) ({                                  \
+    noInterrupts();                                            \
+    uint32_t start = cycles_get();                             \
+    statement;                                                 \
+    uint32_t cycles = cycles_elapsed(start, cycles_get());     \
+    interrupts();                                              \
+    cycles;                                                    \
+  })
+
+static void printResult(const char *name, uint32_t cycles) {
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print(cycles);
+  Serial.println(" cycles");
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+  }
+  benchDigitalPin = pinNametoDigitalPin(BENCH_PIN);
+  cycles_init();
+
+  if (!pin_in_pinmap(BENCH_PIN, PinMap_PWM)) {
+    Serial.println("BENCH_PIN has no PWM channel");
+    while (1) {
+    }
+  }
+  Serial.print("Core clock: ");
+  Serial.print(SystemCoreClock);
+  Serial.println(" Hz");
+  // First call configures the timer and the pin
+  printResult("First analogWrite()", MEASURE(analogWrite(benchDigitalPin, 128)));
+}
+
+void loop() {
+  // Lookups done by analogWrite() on the first call of a pin, and by analogRead()
+  printResult("pinmap_peripheral(PinMap_PWM)", MEASURE((void)pinmap_peripheral(BENCH_PIN, PinMap_PWM)));
+  printResult("PinMap_PWM scan", MEASURE((void)scanPeripheral(BENCH_PIN, PinMap_PWM)));
+  printResult("pinmap_function(PinMap_PWM)", MEASURE((void)pinmap_function(BENCH_PIN, PinMap_PWM)));
+  printResult("pin_in_pinmap(PinMap_ADC)", MEASURE((void)pin_in_pinmap(BENCH_PIN, PinMap_ADC)));
+  // Duty cycle update of a running pin
+  value = (value + 64) & 0xFF;
+  printResult("analogWrite()", MEASURE(analogWrite(benchDigitalPin, value)));
+  Serial.println();
+  delay(2000);
+}
@@ -0,0 +1,68 @@
+/*
+  FastPinCycles
+
+  This example code is in the public domain.
+
+  Measures the number of core clock cycles of a pin write and toggle with
+  digitalWrite()/digitalToggle() and with FastPin, and prints them on Serial.
+
+  Cycles are counted with the core cycle counter (cycles.h): DWT, or SysTick
+  on Cortex-M0/M0+ which have no DWT. Each measure is done with interrupts
+  disabled, loop overhead is removed.
+
+  BENCH_PIN (PA5, the LED of most Nucleo-64 boards) is driven by the measures.
+*/
+
+#ifndef BENCH_PIN
+#define BENCH_PIN PA_5
+#endif
+
+#define LOOPS 100
+
+typedef FastPin<BENCH_PIN> benchPin;
+static uint32_t benchDigitalPin;
+static uint32_t overhead;
+
+// Run LOOPS times the statement and return the number of cycles
+#define MEASURE(statement) ({                                  \
+    noInterrupts();                                            \
+    uint32_t start = cycles_get();                             \
+    for (uint32_t i = 0; i < LOOPS; i++) {                     \
+      statement;                                               \
+      __asm volatile("" ::: "memory");                         \
+    }                                                          \
+    uint32_t cycles = cycles_elapsed(start, cycles_get());     \
+    interrupts();                                              \
+    cycles;                                                    \
+  })
+
+static void printResult(const char *name, uint32_t cycles) {
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print((cycles > overhead) ? (cycles - overhead) / LOOPS : 0);
+  Serial.println(" cycles");
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+  }
+  benchDigitalPin = pinNametoDigitalPin(BENCH_PIN);
+  pinMode(benchDigitalPin, OUTPUT);
+  cycles_init();
+
+  overhead = MEASURE((void)0);
+}
+
+void loop() {
+  Serial.print("Core clock: ");
+  Serial.print(SystemCoreClock);
+  Serial.println(" Hz");
+  printResult("digitalWrite()", MEASURE(digitalWrite(benchDigitalPin, HIGH)));
+  printResult("digitalToggle()", MEASURE(digitalToggle(benchDigitalPin)));
+  printResult("FastPin::write()", MEASURE(benchPin::write(HIGH)));
+  printResult("FastPin::high()", MEASURE(benchPin::high()));
+  printResult("FastPin::toggle()", MEASURE(benchPin::toggle()));
+  Serial.println();
+  delay(2000);
+}
@@ -0,0 +1,107 @@
+/*
+  InterruptLatency
+
+  This example code is in the public domain.
+
+  Measures the number of core clock cycles from an EXTI event to the first
+  instruction of the attachInterrupt() callback, and prints them on Serial.
+  The event is generated by software (EXTI software interrupt register), so
+  no wiring is needed. The three attachInterrupt() flavors are measured:
+  function without parameter, function with parameter and std::function.
+
+  Cycles are counted with the core cycle counter (cycles.h): DWT, or SysTick
+  on Cortex-M0/M0+ which have no DWT. Minimum and maximum of SAMPLES events
+  are printed, the time to read the counter is removed.
+
+  BENCH_PIN (PA0) is set as input with interrupt: keep it at a steady level.
+*/
+
+#include "stm32yyxx_ll_exti.h"
+
+#ifndef BENCH_PIN
+#define BENCH_PIN PA_0
+#endif
+
+#define SAMPLES 16
+
+static uint32_t benchDigitalPin;
+static uint32_t benchLine;
+static uint32_t overhead;
+static volatile uint32_t callbackCycles;
+static volatile bool callbackDone;
+
+static void callbackVoid(void) {
+  callbackCycles = cycles_get();
+  callbackDone = true;
+}
+
+static void callbackArg(void *arg) {
+  callbackCycles = cycles_get();
+  *(volatile bool *)arg = true;
+}
+
+// Generate the event and return the number of cycles until the callback
+static uint32_t measureOnce(void) {
+  callbackDone = false;
+  uint32_t start = cycles_get();
+  LL_EXTI_GenerateSWI_0_31(benchLine);
+  while (!callbackDone) {
+  }
+  return cycles_elapsed(start, callbackCycles);
+}
+
+static void measure(const char *name) {
+  uint32_t min = UINT32_MAX;
+  uint32_t max = 0;
+
+  for (uint32_t i = 0; i < SAMPLES; i++) {
+    uint32_t cycles = measureOnce();
+    cycles = (cycles > overhead) ? (cycles - overhead) : 0;
+    min = (cycles < min) ? cycles : min;
+    max = (cycles > max) ? cycles : max;
+  }
+  detachInterrupt(benchDigitalPin);
+  Serial.print(name);
+  Serial.print(": min ");
+  Serial.print(min);
+  Serial.print(", max ");
+  Serial.print(max);
+  Serial.println(" cycles");
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) {
+  }
+  benchDigitalPin = pinNametoDigitalPin(BENCH_PIN);
+  benchLine = digitalPinToBitMask(benchDigitalPin);
+  cycles_init();
+
+  noInterrupts();
+  uint32_t start = cycles_get();
+  overhead = cycles_elapsed(start, cycles_get());
+  interrupts();
+}
+
+void loop() {
+  Serial.print("Core clock: ");
+  Serial.print(SystemCoreClock);
+  Serial.println(" Hz");
+
+  attachInterrupt(benchDigitalPin, callbackVoid, RISING);
+  measure("void (*)(void)");
+
+  attachInterrupt(benchDigitalPin, callbackArg, (void *)&callbackDone, RISING);
+  measure("void (*)(void *)");
+
+  uint32_t count = 0;
+  attachInterrupt(benchDigitalPin, [&count]() {
+    callbackCycles = cycles_get();
+    count++;
+    callbackDone = true;
+  }, RISING);
+  measure("std::function");
+
+  Serial.println();
+  delay(2000);
+}
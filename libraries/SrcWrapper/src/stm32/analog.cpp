@@ -113,6 +113,62 @@ static PinName g_current_pin = NC;
 #define ADC_REGULAR_RANK_1  1
 #endif
 
+#ifdef ADC_OVERSAMPLING_AVAILABLE
+/* Hardware oversampler limits */
+#if defined(ADC_OVERSAMPLING_RATIO_2)
+#define ADC_OVERSAMPLING_RATIO_MAX  256
+#else
+#define ADC_OVERSAMPLING_RATIO_MAX  1024
+#endif
+#if defined(ADC_RIGHTBITSHIFT_11)
+#define ADC_RIGHTBITSHIFT_MAX       11
+#else
+#define ADC_RIGHTBITSHIFT_MAX       8
+#endif
+
+/* Hardware oversampling settings, ratio 1 means oversampler disabled */
+static uint32_t g_adc_ovs_ratio = 1;
+static uint32_t g_adc_ovs_shift = 0;
+#endif /* ADC_OVERSAMPLING_AVAILABLE */
+
+#ifdef ADC_WATCHDOG_AVAILABLE
+/* ADC interrupt serving the analog watchdog (ADC1 and ADC2 when available) */
+#if defined(STM32F2xx) || defined(STM32F4xx) || defined(STM32F7xx) || \
+    defined(STM32H7xx)
+#define ADC_AWD_IRQn            ADC_IRQn
+#define ADC_AWD_IRQHandler      ADC_IRQHandler
+#elif defined(STM32G4xx)
+#define ADC_AWD_IRQn            ADC1_2_IRQn
+#define ADC_AWD_IRQHandler      ADC1_2_IRQHandler
+#elif defined(STM32G0xx) && defined(COMP1)
+#define ADC_AWD_IRQn            ADC1_COMP_IRQn
+#define ADC_AWD_IRQHandler      ADC1_COMP_IRQHandler
+#else
+#define ADC_AWD_IRQn            ADC1_IRQn
+#define ADC_AWD_IRQHandler      ADC1_IRQHandler
+#endif
+#endif /* ADC_WATCHDOG_AVAILABLE */
+
+#ifndef ADC_AWD_IRQ_PRIO
+#define ADC_AWD_IRQ_PRIO        1
+#endif
+#ifndef ADC_AWD_IRQ_SUBPRIO
+#define ADC_AWD_IRQ_SUBPRIO     0
+#endif
+
+#if defined(ADC_IT_AWD1)
+#define ADC_IT_AWD_USED         ADC_IT_AWD1
+#define ADC_FLAG_AWD_USED       ADC_FLAG_AWD1
+#else
+#define ADC_IT_AWD_USED         ADC_IT_AWD
+#define ADC_FLAG_AWD_USED       ADC_FLAG_AWD
+#endif
+
+#ifdef ADC_WATCHDOG_AVAILABLE
+static void adc_watchdog_pause(PinName pin);
+static void adc_watchdog_resume(void);
+#endif
+
 /* Private Functions */
 static uint32_t get_adc_channel(PinName pin)
 {
@@ -295,6 +351,41 @@ uint32_t get_pwm_channel(PinName pin)
   }
   return channel;
 }
+
+#if (defined(HAL_ADC_MODULE_ENABLED) && !defined(HAL_ADC_MODULE_ONLY)) ||\
+    (defined(HAL_DAC_MODULE_ENABLED) && !defined(HAL_DAC_MODULE_ONLY))
+/**
+  * @brief  Check that a timer is not used yet (analogWrite, tone, servo,
+  *         HardwareTimer object...)
+  * @param  tim : timer instance
+  * @retval true if the timer can be used to trigger a stream
+  */
+static bool trgo_timer_available(TIM_TypeDef *tim)
+{
+  uint32_t index = get_timer_index(tim);
+
+  return (index < TIMER_NUM) && (HardwareTimer_Handle[index] == NULL);
+}
+
+/**
+  * @brief  Start a timer which update event is output on TRGO, used to
+  *         trigger ADC conversions or DAC updates at a fixed rate
+  * @note   Timer must be available, see trgo_timer_available(). Returned
+  *         object has to be deleted once the stream is stopped.
+  * @param  tim : timer instance
+  * @param  frequency : update frequency in Hz
+  * @retval HardwareTimer object driving the timer
+  */
+static HardwareTimer *trgo_timer_start(TIM_TypeDef *tim, uint32_t frequency)
+{
+  HardwareTimer *HT = new HardwareTimer(tim);
+
+  HT->setOverflow(frequency, HERTZ_FORMAT);
+  HT->setTriggerOutput(TIM_TRGO_UPDATE);
+  HAL_TIM_Base_Start(HT->getHandle());
+  return HT;
+}
+#endif /* HAL_ADC_MODULE_ENABLED || HAL_DAC_MODULE_ENABLED */
 #endif /* HAL_TIM_MODULE_ENABLED && !HAL_TIM_MODULE_ONLY */
 
 #if defined(HAL_DAC_MODULE_ENABLED) && !defined(HAL_DAC_MODULE_ONLY)
@@ -555,6 +646,331 @@ void dac_stop(PinName pin)
     return;
   }
 }
+
+#if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
+////////////////////// DAC TIMER TRIGGERED STREAMING ///////////////////////////
+
+/* DMA stream/channel serving DAC1 channel 1 */
+#if defined(DMAMUX1) && defined(DMA1_Stream1)
+#define DAC_DMA_INSTANCE        DMA1_Stream1
+#define DAC_DMA_IRQn            DMA1_Stream1_IRQn
+#define DAC_DMA_IRQHandler      DMA1_Stream1_IRQHandler
+#elif defined(DMAMUX1) && defined(STM32G0xx)
+#define DAC_DMA_INSTANCE        DMA1_Channel2
+#define DAC_DMA_IRQn            DMA1_Channel2_3_IRQn
+#define DAC_DMA_IRQHandler      DMA1_Channel2_3_IRQHandler
+#elif defined(DMAMUX1)
+#define DAC_DMA_INSTANCE        DMA1_Channel2
+#define DAC_DMA_IRQn            DMA1_Channel2_IRQn
+#define DAC_DMA_IRQHandler      DMA1_Channel2_IRQHandler
+#elif defined(DMA1_Stream5)
+#define DAC_DMA_INSTANCE        DMA1_Stream5
+#define DAC_DMA_IRQn            DMA1_Stream5_IRQn
+#define DAC_DMA_IRQHandler      DMA1_Stream5_IRQHandler
+#elif defined(STM32L4xx)
+#define DAC_DMA_INSTANCE        DMA1_Channel3
+#define DAC_DMA_IRQn            DMA1_Channel3_IRQn
+#define DAC_DMA_IRQHandler      DMA1_Channel3_IRQHandler
+#elif defined(STM32L1xx)
+#define DAC_DMA_INSTANCE        DMA1_Channel2
+#define DAC_DMA_IRQn            DMA1_Channel2_IRQn
+#define DAC_DMA_IRQHandler      DMA1_Channel2_IRQHandler
+#elif defined(STM32L0xx)
+#define DAC_DMA_INSTANCE        DMA1_Channel2
+#define DAC_DMA_IRQn            DMA1_Channel2_3_IRQn
+#define DAC_DMA_IRQHandler      DMA1_Channel2_3_IRQHandler
+#elif defined(STM32F0xx)
+#define DAC_DMA_INSTANCE        DMA1_Channel3
+#define DAC_DMA_IRQn            DMA1_Channel2_3_IRQn
+#define DAC_DMA_IRQHandler      DMA1_Channel2_3_IRQHandler
+#endif
+
+#ifndef DAC_DMA_IRQ_PRIO
+#define DAC_DMA_IRQ_PRIO        1
+#endif
+#ifndef DAC_DMA_IRQ_SUBPRIO
+#define DAC_DMA_IRQ_SUBPRIO     0
+#endif
+
+#ifdef DAC_DMA_INSTANCE
+typedef struct {
+  DAC_HandleTypeDef handle;
+  DMA_HandleTypeDef hdma;
+  HardwareTimer *timer;
+  uint16_t *buffer;
+  uint32_t length;
+  dac_stream_callback_t callback;
+} dac_stream_t;
+
+static dac_stream_t dac_stream = {};
+
+/**
+  * @brief  Retrieve the DAC trigger matching a timer TRGO
+  * @param  tim : timer instance
+  * @retval DAC trigger or DAC_TRIGGER_NONE if not supported
+  */
+static uint32_t get_dac_trigger(TIM_TypeDef *tim)
+{
+  uint32_t trigger = DAC_TRIGGER_NONE;
+
+  if (tim == NP) {
+    return trigger;
+  }
+#if defined(TIM1) && defined(DAC_TRIGGER_T1_TRGO)
+  else if (tim == TIM1) {
+    trigger = DAC_TRIGGER_T1_TRGO;
+  }
+#endif
+#if defined(TIM2) && defined(DAC_TRIGGER_T2_TRGO)
+  else if (tim == TIM2) {
+    trigger = DAC_TRIGGER_T2_TRGO;
+  }
+#endif
+#if defined(TIM3) && defined(DAC_TRIGGER_T3_TRGO)
+  else if (tim == TIM3) {
+    trigger = DAC_TRIGGER_T3_TRGO;
+  }
+#endif
+#if defined(TIM4) && defined(DAC_TRIGGER_T4_TRGO)
+  else if (tim == TIM4) {
+    trigger = DAC_TRIGGER_T4_TRGO;
+  }
+#endif
+#if defined(TIM5) && defined(DAC_TRIGGER_T5_TRGO)
+  else if (tim == TIM5) {
+    trigger = DAC_TRIGGER_T5_TRGO;
+  }
+#endif
+#if defined(TIM6) && defined(DAC_TRIGGER_T6_TRGO)
+  else if (tim == TIM6) {
+    trigger = DAC_TRIGGER_T6_TRGO;
+  }
+#endif
+#if defined(TIM7) && defined(DAC_TRIGGER_T7_TRGO)
+  else if (tim == TIM7) {
+    trigger = DAC_TRIGGER_T7_TRGO;
+  }
+#endif
+#if defined(TIM8) && defined(DAC_TRIGGER_T8_TRGO)
+  else if (tim == TIM8) {
+    trigger = DAC_TRIGGER_T8_TRGO;
+  }
+#endif
+#if defined(TIM15) && defined(DAC_TRIGGER_T15_TRGO)
+  else if (tim == TIM15) {
+    trigger = DAC_TRIGGER_T15_TRGO;
+  }
+#endif
+#if defined(TIM21) && defined(DAC_TRIGGER_T21_TRGO)
+  else if (tim == TIM21) {
+    trigger = DAC_TRIGGER_T21_TRGO;
+  }
+#endif
+  return trigger;
+}
+
+/**
+  * @brief  Configure the DMA feeding DAC channel 1 in circular mode
+  * @param  hdac : DAC handle
+  * @param  hdma : DMA handle
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef dac_dma_init(DAC_HandleTypeDef *hdac, DMA_HandleTypeDef *hdma)
+{
+  __HAL_RCC_DMA1_CLK_ENABLE();
+#ifdef __HAL_RCC_DMAMUX1_CLK_ENABLE
+  __HAL_RCC_DMAMUX1_CLK_ENABLE();
+#endif
+#if defined(DMAMUX1)
+#if defined(DMA_REQUEST_DAC1_CHANNEL1)
+  hdma->Init.Request             = DMA_REQUEST_DAC1_CHANNEL1;
+#else
+  hdma->Init.Request             = DMA_REQUEST_DAC1_CH1;
+#endif
+#elif defined(DMA1_Stream5)
+  hdma->Init.Channel             = DMA_CHANNEL_7;
+#elif defined(STM32L4xx)
+  hdma->Init.Request             = DMA_REQUEST_6;
+#elif defined(STM32L0xx)
+  hdma->Init.Request             = DMA_REQUEST_9;
+#elif defined(HAL_DMA1_CH3_DAC_CH1)
+  __HAL_DMA1_REMAP(HAL_DMA1_CH3_DAC_CH1);
+#endif
+
+  hdma->Instance                 = DAC_DMA_INSTANCE;
+  if (!acquireDma(hdma)) {
+    /* Stream/channel used by a timer */
+    return HAL_ERROR;
+  }
+  hdma->Init.Direction           = DMA_MEMORY_TO_PERIPH;
+  hdma->Init.PeriphInc           = DMA_PINC_DISABLE;
+  hdma->Init.MemInc              = DMA_MINC_ENABLE;
+  hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+  hdma->Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+  hdma->Init.Mode                = DMA_CIRCULAR;
+  hdma->Init.Priority            = DMA_PRIORITY_HIGH;
+#if defined(DMA_FIFOMODE_DISABLE)
+  hdma->Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+#endif
+
+  if (HAL_DMA_Init(hdma) != HAL_OK) {
+    releaseDma(hdma);
+    return HAL_ERROR;
+  }
+  __HAL_LINKDMA(hdac, DMA_Handle1, *hdma);
+
+  HAL_NVIC_SetPriority(DAC_DMA_IRQn, DAC_DMA_IRQ_PRIO, DAC_DMA_IRQ_SUBPRIO);
+  HAL_NVIC_EnableIRQ(DAC_DMA_IRQn);
+  return HAL_OK;
+}
+
+/**
+  * @brief  DMA half-transfer callback of the DAC stream
+  * @note   Installed on the DMA handle in place of the HAL DAC one, so that
+  *         HAL_DAC_ConvHalfCpltCallbackCh1() stays available to the user
+  * @param  hdma: DMA handle
+  * @retval None
+  */
+static void dac_stream_half_cplt(DMA_HandleTypeDef *hdma)
+{
+  UNUSED(hdma);
+  if (dac_stream.callback != NULL) {
+    dac_stream.callback(dac_stream.buffer, dac_stream.length / 2);
+  }
+}
+
+/**
+  * @brief  DMA transfer complete callback of the DAC stream
+  * @note   Installed on the DMA handle in place of the HAL DAC one, so that
+  *         HAL_DAC_ConvCpltCallbackCh1() stays available to the user
+  * @param  hdma: DMA handle
+  * @retval None
+  */
+static void dac_stream_cplt(DMA_HandleTypeDef *hdma)
+{
+  UNUSED(hdma);
+  if (dac_stream.callback != NULL) {
+    dac_stream.callback(dac_stream.buffer + (dac_stream.length / 2), dac_stream.length / 2);
+  }
+}
+#endif /* DAC_DMA_INSTANCE */
+
+/**
+  * @brief  Start streaming samples to a DAC output, one sample per timer
+  *         update event. Samples are fed by DMA in circular mode from buffer,
+  *         used as a double buffer: callback is called each time one half of
+  *         it has been sent, with the address of this half and its length,
+  *         so that it can be refilled while the other half is output.
+  * @note   Only DAC1 channel 1 is supported. Callback is called from DMA
+  *         interrupt context.
+  * @param  pin : the DAC pin
+  * @param  tim : timer instance which TRGO triggers the DAC, not used
+  *               by anything else. It is released when the stream is stopped
+  * @param  frequency : sample rate in Hz
+  * @param  buffer : 12-bit right aligned samples
+  * @param  length : number of samples in buffer (even number)
+  * @param  callback : called each time one half of buffer has been sent,
+  *                    can be NULL to loop on a fixed waveform
+  * @retval true if the stream is started, false otherwise
+  */
+bool dac_stream_start(PinName pin, TIM_TypeDef *tim, uint32_t frequency,
+                      uint16_t *buffer, uint32_t length,
+                      dac_stream_callback_t callback)
+{
+#ifdef DAC_DMA_INSTANCE
+  DAC_HandleTypeDef *hdac = &dac_stream.handle;
+  DAC_ChannelConfTypeDef dacChannelConf = {};
+  uint32_t trigger = get_dac_trigger(tim);
+
+  if ((dac_stream.timer != NULL) || (buffer == NULL) || (length < 2) ||
+      (frequency == 0) || (trigger == DAC_TRIGGER_NONE) || !trgo_timer_available(tim)) {
+    return false;
+  }
+
+  *hdac = {};
+  dac_stream.hdma = {};
+  hdac->Instance = (DAC_TypeDef *)pinmap_peripheral(pin, PinMap_DAC);
+  if ((hdac->Instance != DAC1) || (get_dac_channel(pin) != DAC_CHANNEL_1)) {
+    return false;
+  }
+
+  g_current_pin = pin;
+  if (HAL_DAC_Init(hdac) != HAL_OK) {
+    return false;
+  }
+  dacChannelConf.DAC_Trigger = trigger;
+  dacChannelConf.DAC_OutputBuffer = DAC_OUTPUTBUFFER_ENABLE;
+  if ((HAL_DAC_ConfigChannel(hdac, &dacChannelConf, DAC_CHANNEL_1) != HAL_OK) ||
+      (dac_dma_init(hdac, &dac_stream.hdma) != HAL_OK)) {
+    HAL_DAC_DeInit(hdac);
+    return false;
+  }
+
+  dac_stream.buffer = buffer;
+  dac_stream.length = length & ~1UL;
+  dac_stream.callback = callback;
+
+  if (HAL_DAC_Start_DMA(hdac, DAC_CHANNEL_1, (uint32_t *)buffer, dac_stream.length, DAC_ALIGN_12B_R) != HAL_OK) {
+    HAL_DMA_DeInit(&dac_stream.hdma);
+    releaseDma(&dac_stream.hdma);
+    HAL_DAC_DeInit(hdac);
+    return false;
+  }
+  /* No DAC update until the timer is started */
+  dac_stream.hdma.XferHalfCpltCallback = dac_stream_half_cplt;
+  dac_stream.hdma.XferCpltCallback = dac_stream_cplt;
+
+  dac_stream.timer = trgo_timer_start(tim, frequency);
+  return true;
+#else
+  UNUSED(pin);
+  UNUSED(tim);
+  UNUSED(frequency);
+  UNUSED(buffer);
+  UNUSED(length);
+  UNUSED(callback);
+  return false;
+#endif /* DAC_DMA_INSTANCE */
+}
+
+/**
+  * @brief  Stop the DAC stream started by dac_stream_start()
+  * @param  None
+  * @retval None
+  */
+void dac_stream_stop(void)
+{
+#ifdef DAC_DMA_INSTANCE
+  if (dac_stream.timer == NULL) {
+    return;
+  }
+  HAL_TIM_Base_Stop(dac_stream.timer->getHandle());
+  delete dac_stream.timer;
+  dac_stream.timer = NULL;
+
+  HAL_DAC_Stop_DMA(&dac_stream.handle, DAC_CHANNEL_1);
+  HAL_NVIC_DisableIRQ(DAC_DMA_IRQn);
+  HAL_DMA_DeInit(&dac_stream.hdma);
+  releaseDma(&dac_stream.hdma);
+  HAL_DAC_DeInit(&dac_stream.handle);
+  dac_stream.callback = NULL;
+#endif /* DAC_DMA_INSTANCE */
+}
+
+#ifdef DAC_DMA_INSTANCE
+/**
+  * @brief  DMA IRQ handler used by the DAC stream
+  * @note   Weak: a sketch or a library using this DMA stream/channel for
+  *         another purpose can define its own handler
+  * @param  None
+  * @retval None
+  */
+WEAK void DAC_DMA_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&dac_stream.hdma);
+}
+#endif /* DAC_DMA_INSTANCE */
+#endif /* HAL_TIM_MODULE_ENABLED && !HAL_TIM_MODULE_ONLY */
 #endif //HAL_DAC_MODULE_ENABLED && !HAL_DAC_MODULE_ONLY
 
 
@@ -756,69 +1172,101 @@ void HAL_ADC_MspDeInit(ADC_HandleTypeDef *hadc)
 }
 
 /**
-  * @brief  This function will set the ADC to the required value
+  * @brief  Retrieve the ADC instance and channel to use for a pin
   * @param  pin : the pin to use
-  * @param  resolution : resolution for converted data: 6/8/10/12/14/16
-  * @retval the value of the adc
+  * @param  hadc : ADC handle, Instance field is updated
+  * @param  samplingTime : sampling time to use for this channel (updated)
+  * @retval ADC channel
   */
-uint16_t adc_read_value(PinName pin, uint32_t resolution)
+static uint32_t adc_get_pin_config(PinName pin, ADC_HandleTypeDef *hadc, uint32_t *samplingTime)
 {
-  ADC_HandleTypeDef AdcHandle = {};
-  ADC_ChannelConfTypeDef  AdcChannelConf = {};
-  __IO uint16_t uhADCxConvertedValue = 0;
-  uint32_t samplingTime = ADC_SAMPLINGTIME;
   uint32_t channel = 0;
 
   if ((pin & PADC_BASE) && (pin < ANA_START)) {
 #if defined(STM32H7xx)
-    AdcHandle.Instance = ADC3;
+    hadc->Instance = ADC3;
 #else
-    AdcHandle.Instance = ADC1;
+    hadc->Instance = ADC1;
 #if defined(ADC5) && defined(ADC_CHANNEL_TEMPSENSOR_ADC5)
     if (pin == PADC_TEMP_ADC5) {
-      AdcHandle.Instance = ADC5;
+      hadc->Instance = ADC5;
     }
 #endif
 #endif
     channel = get_adc_internal_channel(pin);
-    samplingTime = ADC_SAMPLINGTIME_INTERNAL;
+    *samplingTime = ADC_SAMPLINGTIME_INTERNAL;
   } else {
-    AdcHandle.Instance = (ADC_TypeDef *)pinmap_peripheral(pin, PinMap_ADC);
+    hadc->Instance = (ADC_TypeDef *)pinmap_peripheral(pin, PinMap_ADC);
     channel = get_adc_channel(pin);
   }
+  return channel;
+}
 
-  if (AdcHandle.Instance == NP) {
-    return 0;
+#ifdef ADC_OVERSAMPLING_AVAILABLE
+/**
+  * @brief  Configure the hardware oversampler used by next ADC conversions.
+  *         Sum of 'ratio' conversions is right shifted by 'shift' bits.
+  * @note   Only available on series with an ADC hardware oversampler
+  *         (L0, L4, G0, G4, H7, MP1, WB), see ADC_OVERSAMPLING_AVAILABLE.
+  * @param  ratio : oversampling ratio, power of 2. 1 disables oversampling
+  * @param  shift : right bit shift applied to the sum
+  * @retval true if settings are supported, false otherwise
+  */
+bool adc_set_oversampling(uint32_t ratio, uint32_t shift)
+{
+  if ((ratio == 0) || ((ratio & (ratio - 1)) != 0)) {
+    return false;
+  }
+  if (ratio == 1) {
+    shift = 0;
+  }
+  if ((ratio > ADC_OVERSAMPLING_RATIO_MAX) || (shift > ADC_RIGHTBITSHIFT_MAX)) {
+    return false;
   }
+  g_adc_ovs_ratio = ratio;
+  g_adc_ovs_shift = shift;
+  return true;
+}
+#endif /* ADC_OVERSAMPLING_AVAILABLE */
 
+/**
+  * @brief  Fill the ADC handle init structure for single software triggered
+  *         conversions. Caller can then override the fields it needs.
+  * @param  hadc : ADC handle
+  * @param  resolution : resolution for converted data: 6/8/10/12/14/16
+  * @param  samplingTime : sampling time used for common sampling time settings
+  * @retval None
+  */
+static void adc_set_init(ADC_HandleTypeDef *hadc, uint32_t resolution, uint32_t samplingTime)
+{
 #ifdef ADC_CLOCK_DIV
-  AdcHandle.Init.ClockPrescaler        = ADC_CLOCK_DIV;                 /* (A)synchronous clock mode, input ADC clock divided */
+  hadc->Init.ClockPrescaler        = ADC_CLOCK_DIV;                 /* (A)synchronous clock mode, input ADC clock divided */
 #endif
 #ifdef ADC_RESOLUTION_12B
   switch (resolution) {
 #ifdef ADC_RESOLUTION_6B
     case 6:
-      AdcHandle.Init.Resolution          = ADC_RESOLUTION_6B;             /* resolution for converted data */
+      hadc->Init.Resolution          = ADC_RESOLUTION_6B;             /* resolution for converted data */
       break;
 #endif
     case 8:
-      AdcHandle.Init.Resolution          = ADC_RESOLUTION_8B;             /* resolution for converted data */
+      hadc->Init.Resolution          = ADC_RESOLUTION_8B;             /* resolution for converted data */
       break;
     case 10:
-      AdcHandle.Init.Resolution          = ADC_RESOLUTION_10B;            /* resolution for converted data */
+      hadc->Init.Resolution          = ADC_RESOLUTION_10B;            /* resolution for converted data */
       break;
     case 12:
     default:
-      AdcHandle.Init.Resolution          = ADC_RESOLUTION_12B;            /* resolution for converted data */
+      hadc->Init.Resolution          = ADC_RESOLUTION_12B;            /* resolution for converted data */
       break;
 #ifdef ADC_RESOLUTION_14B
     case 14:
-      AdcHandle.Init.Resolution          = ADC_RESOLUTION_14B;            /* resolution for converted data */
+      hadc->Init.Resolution          = ADC_RESOLUTION_14B;            /* resolution for converted data */
       break;
 #endif
 #ifdef ADC_RESOLUTION_16B
     case 16:
-      AdcHandle.Init.Resolution          = ADC_RESOLUTION_16B;            /* resolution for converted data */
+      hadc->Init.Resolution          = ADC_RESOLUTION_16B;            /* resolution for converted data */
       break;
 #endif
   }
@@ -826,101 +1274,137 @@ uint16_t adc_read_value(PinName pin, uint32_t resolution)
   UNUSED(resolution);
 #endif
 #ifdef ADC_DATAALIGN_RIGHT
-  AdcHandle.Init.DataAlign             = ADC_DATAALIGN_RIGHT;           /* Right-alignment for converted data */
+  hadc->Init.DataAlign             = ADC_DATAALIGN_RIGHT;           /* Right-alignment for converted data */
 #endif
 #ifdef ADC_SCAN_SEQ_FIXED
-  AdcHandle.Init.ScanConvMode          = ADC_SCAN_SEQ_FIXED;            /* Sequencer disabled (ADC conversion on only 1 channel: channel set on rank 1) */
+  hadc->Init.ScanConvMode          = ADC_SCAN_SEQ_FIXED;            /* Sequencer disabled (ADC conversion on only 1 channel: channel set on rank 1) */
 #else
-  AdcHandle.Init.ScanConvMode          = DISABLE;                       /* Sequencer disabled (ADC conversion on only 1 channel: channel set on rank 1) */
+  hadc->Init.ScanConvMode          = DISABLE;                       /* Sequencer disabled (ADC conversion on only 1 channel: channel set on rank 1) */
 #endif
 #ifdef ADC_EOC_SINGLE_CONV
-  AdcHandle.Init.EOCSelection          = ADC_EOC_SINGLE_CONV;           /* EOC flag picked-up to indicate conversion end */
+  hadc->Init.EOCSelection          = ADC_EOC_SINGLE_CONV;           /* EOC flag picked-up to indicate conversion end */
 #endif
 #if !defined(STM32F1xx) && !defined(STM32F2xx) && !defined(STM32F4xx) && \
     !defined(STM32F7xx) && !defined(STM32F373xC) && !defined(STM32F378xx)
-  AdcHandle.Init.LowPowerAutoWait      = DISABLE;                       /* Auto-delayed conversion feature disabled */
+  hadc->Init.LowPowerAutoWait      = DISABLE;                       /* Auto-delayed conversion feature disabled */
 #endif
 #if !defined(STM32F1xx) && !defined(STM32F2xx) && !defined(STM32F3xx) && \
     !defined(STM32F4xx) && !defined(STM32F7xx) && !defined(STM32G4xx) && \
     !defined(STM32H7xx) && !defined(STM32L4xx) && !defined(STM32MP1xx) && \
     !defined(STM32WBxx)
-  AdcHandle.Init.LowPowerAutoPowerOff  = DISABLE;                       /* ADC automatically powers-off after a conversion and automatically wakes-up when a new conversion is triggered */
+  hadc->Init.LowPowerAutoPowerOff  = DISABLE;                       /* ADC automatically powers-off after a conversion and automatically wakes-up when a new conversion is triggered */
 #endif
 #ifdef ADC_CHANNELS_BANK_A
-  AdcHandle.Init.ChannelsBank          = ADC_CHANNELS_BANK_A;
+  hadc->Init.ChannelsBank          = ADC_CHANNELS_BANK_A;
 #endif
-  AdcHandle.Init.ContinuousConvMode    = DISABLE;                       /* Continuous mode disabled to have only 1 conversion at each conversion trig */
+  hadc->Init.ContinuousConvMode    = DISABLE;                       /* Continuous mode disabled to have only 1 conversion at each conversion trig */
 #if !defined(STM32F0xx) && !defined(STM32L0xx)
-  AdcHandle.Init.NbrOfConversion       = 1;                             /* Specifies the number of ranks that will be converted within the regular group sequencer. */
+  hadc->Init.NbrOfConversion       = 1;                             /* Specifies the number of ranks that will be converted within the regular group sequencer. */
 #endif
-  AdcHandle.Init.DiscontinuousConvMode = DISABLE;                       /* Parameter discarded because sequencer is disabled */
+  hadc->Init.DiscontinuousConvMode = DISABLE;                       /* Parameter discarded because sequencer is disabled */
 #if !defined(STM32F0xx) && !defined(STM32G0xx) && !defined(STM32L0xx)
-  AdcHandle.Init.NbrOfDiscConversion   = 0;                             /* Parameter discarded because sequencer is disabled */
+  hadc->Init.NbrOfDiscConversion   = 0;                             /* Parameter discarded because sequencer is disabled */
 #endif
-  AdcHandle.Init.ExternalTrigConv      = ADC_SOFTWARE_START;            /* Software start to trig the 1st conversion manually, without external event */
+  hadc->Init.ExternalTrigConv      = ADC_SOFTWARE_START;            /* Software start to trig the 1st conversion manually, without external event */
 #if !defined(STM32F1xx) && !defined(STM32F373xC) && !defined(STM32F378xx)
-  AdcHandle.Init.ExternalTrigConvEdge  = ADC_EXTERNALTRIGCONVEDGE_NONE; /* Parameter discarded because software trigger chosen */
+  hadc->Init.ExternalTrigConvEdge  = ADC_EXTERNALTRIGCONVEDGE_NONE; /* Parameter discarded because software trigger chosen */
 #endif
 #if !defined(STM32F1xx) && !defined(STM32H7xx) && !defined(STM32MP1xx) && \
     !defined(STM32F373xC) && !defined(STM32F378xx)
-  AdcHandle.Init.DMAContinuousRequests = DISABLE;                       /* DMA one-shot mode selected (not applied to this example) */
+  hadc->Init.DMAContinuousRequests = DISABLE;                       /* DMA one-shot mode selected (not applied to this example) */
 #endif
 #ifdef ADC_CONVERSIONDATA_DR
-  AdcHandle.Init.ConversionDataManagement = ADC_CONVERSIONDATA_DR;      /* Regular Conversion data stored in DR register only */
+  hadc->Init.ConversionDataManagement = ADC_CONVERSIONDATA_DR;      /* Regular Conversion data stored in DR register only */
 #endif
 #ifdef ADC_OVR_DATA_OVERWRITTEN
-  AdcHandle.Init.Overrun               = ADC_OVR_DATA_OVERWRITTEN;      /* DR register is overwritten with the last conversion result in case of overrun */
+  hadc->Init.Overrun               = ADC_OVR_DATA_OVERWRITTEN;      /* DR register is overwritten with the last conversion result in case of overrun */
 #endif
 #ifdef ADC_LEFTBITSHIFT_NONE
-  AdcHandle.Init.LeftBitShift          = ADC_LEFTBITSHIFT_NONE;         /* No bit shift left applied on the final ADC convesion data */
+  hadc->Init.LeftBitShift          = ADC_LEFTBITSHIFT_NONE;         /* No bit shift left applied on the final ADC convesion data */
 #endif
 
 #if defined(STM32F0xx)
-  AdcHandle.Init.SamplingTimeCommon    = samplingTime;
+  hadc->Init.SamplingTimeCommon    = samplingTime;
 #endif
 #if defined(STM32G0xx)
-  AdcHandle.Init.SamplingTimeCommon1   = samplingTime;              /* Set sampling time common to a group of channels. */
-  AdcHandle.Init.SamplingTimeCommon2   = samplingTime;              /* Set sampling time common to a group of channels, second common setting possible.*/
+  hadc->Init.SamplingTimeCommon1   = samplingTime;              /* Set sampling time common to a group of channels. */
+  hadc->Init.SamplingTimeCommon2   = samplingTime;              /* Set sampling time common to a group of channels, second common setting possible.*/
 #endif
 #if defined(STM32L0xx)
-  AdcHandle.Init.LowPowerFrequencyMode = DISABLE;                       /* To be enabled only if ADC clock < 2.8 MHz */
-  AdcHandle.Init.SamplingTime          = samplingTime;
+  hadc->Init.LowPowerFrequencyMode = DISABLE;                       /* To be enabled only if ADC clock < 2.8 MHz */
+  hadc->Init.SamplingTime          = samplingTime;
 #endif
 #if !defined(STM32F0xx) && !defined(STM32F1xx) && !defined(STM32F2xx) && \
     !defined(STM32F3xx) && !defined(STM32F4xx) && !defined(STM32F7xx) && \
     !defined(STM32L1xx)
-  AdcHandle.Init.OversamplingMode      = DISABLE;
-  /* AdcHandle.Init.Oversample ignore for STM32L0xx as oversampling disabled */
-  /* AdcHandle.Init.Oversampling ignored for other as oversampling disabled */
+#ifdef ADC_OVERSAMPLING_AVAILABLE
+  if (g_adc_ovs_ratio > 1) {
+    hadc->Init.OversamplingMode      = ENABLE;
+#if defined(STM32L0xx)
+    ADC_OversamplingTypeDef *ovs = &hadc->Init.Oversample;
+#else
+    ADC_OversamplingTypeDef *ovs = &hadc->Init.Oversampling;
+#endif
+#if defined(ADC_OVERSAMPLING_RATIO_2)
+    /* Ratio field holds log2(ratio) - 1 */
+    uint32_t ratio_log2 = 0;
+    while ((1UL << ratio_log2) < g_adc_ovs_ratio) {
+      ratio_log2++;
+    }
+    ovs->Ratio                       = (ratio_log2 - 1) * ADC_OVERSAMPLING_RATIO_4;
+#else
+    ovs->Ratio                       = g_adc_ovs_ratio;
+#endif
+    ovs->RightBitShift               = g_adc_ovs_shift * ADC_RIGHTBITSHIFT_1;
+    ovs->TriggeredMode               = ADC_TRIGGEREDMODE_SINGLE_TRIGGER; /* All oversampled conversions done on one trigger */
+#ifdef ADC_REGOVERSAMPLING_CONTINUED_MODE
+    ovs->OversamplingStopReset       = ADC_REGOVERSAMPLING_CONTINUED_MODE;
+#endif
+  } else
+#endif /* ADC_OVERSAMPLING_AVAILABLE */
+  {
+    hadc->Init.OversamplingMode      = DISABLE;
+    /* hadc->Init.Oversample ignore for STM32L0xx as oversampling disabled */
+    /* hadc->Init.Oversampling ignored for other as oversampling disabled */
+  }
 #endif
 #if defined(ADC_CFGR_DFSDMCFG) && defined(DFSDM1_Channel0)
-  AdcHandle.Init.DFSDMConfig           = ADC_DFSDM_MODE_DISABLE;        /* ADC conversions are not transferred by DFSDM. */
+  hadc->Init.DFSDMConfig           = ADC_DFSDM_MODE_DISABLE;        /* ADC conversions are not transferred by DFSDM. */
 #endif
 #ifdef ADC_TRIGGER_FREQ_HIGH
-  AdcHandle.Init.TriggerFrequencyMode  = ADC_TRIGGER_FREQ_HIGH;
+  hadc->Init.TriggerFrequencyMode  = ADC_TRIGGER_FREQ_HIGH;
+#endif
+#if !defined(STM32F0xx) && !defined(STM32G0xx) && !defined(STM32L0xx)
+  UNUSED(samplingTime);
 #endif
 
-  AdcHandle.State = HAL_ADC_STATE_RESET;
-  AdcHandle.DMA_Handle = NULL;
-  AdcHandle.Lock = HAL_UNLOCKED;
+  hadc->State = HAL_ADC_STATE_RESET;
+  hadc->DMA_Handle = NULL;
+  hadc->Lock = HAL_UNLOCKED;
   /* Some other ADC_HandleTypeDef fields exists but not required */
+}
 
-  g_current_pin = pin; /* Needed for HAL_ADC_MspInit*/
-
-  if (HAL_ADC_Init(&AdcHandle) != HAL_OK) {
-    return 0;
-  }
+/**
+  * @brief  Configure the regular channel of an initialized ADC
+  * @param  hadc : ADC handle
+  * @param  channel : ADC channel to convert
+  * @param  samplingTime : sampling time of the channel
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef adc_config_channel(ADC_HandleTypeDef *hadc, uint32_t channel, uint32_t samplingTime)
+{
+  ADC_ChannelConfTypeDef  AdcChannelConf = {};
 
   AdcChannelConf.Channel      = channel;                          /* Specifies the channel to configure into ADC */
 
 #if defined(STM32L4xx) || defined(STM32WBxx)
-  if (!IS_ADC_CHANNEL(&AdcHandle, AdcChannelConf.Channel)) {
+  if (!IS_ADC_CHANNEL(hadc, AdcChannelConf.Channel)) {
 #elif defined(STM32G4xx)
-  if (!IS_ADC_CHANNEL(&AdcHandle, AdcChannelConf.Channel)) {
+  if (!IS_ADC_CHANNEL(hadc, AdcChannelConf.Channel)) {
 #else
   if (!IS_ADC_CHANNEL(AdcChannelConf.Channel)) {
 #endif /* STM32L4xx || STM32WBxx */
-    return 0;
+    return HAL_ERROR;
   }
 #ifdef ADC_SCAN_SEQ_FIXED
   AdcChannelConf.Rank         = ADC_RANK_CHANNEL_NUMBER;          /* Enable the rank of the selected channels when not fully configurable */
@@ -934,6 +1418,9 @@ uint16_t adc_read_value(PinName pin, uint32_t resolution)
   AdcChannelConf.SamplingTime = ADC_SAMPLINGTIME_COMMON_1;        /* Sampling time value to be set for the selected channel */
 #endif
 #endif
+#if defined(STM32L0xx) || defined(STM32G0xx)
+  UNUSED(samplingTime);
+#endif
 #if !defined(STM32F0xx) && !defined(STM32F1xx) && !defined(STM32F2xx) && \
     !defined(STM32F4xx) && !defined(STM32F7xx) && !defined(STM32G0xx) && \
     !defined(STM32L0xx) && !defined(STM32L1xx) && \
@@ -951,30 +1438,70 @@ uint16_t adc_read_value(PinName pin, uint32_t resolution)
   AdcChannelConf.OffsetSignedSaturation = DISABLE;                /* Signed saturation feature is not used */
 #endif
 
-  /*##-2- Configure ADC regular channel ######################################*/
-  if (HAL_ADC_ConfigChannel(&AdcHandle, &AdcChannelConf) != HAL_OK) {
-    /* Channel Configuration Error */
-    return 0;
-  }
+  return HAL_ADC_ConfigChannel(hadc, &AdcChannelConf);
+}
 
+/**
+  * @brief  Run the ADC calibration when available
+  * @param  hadc : ADC handle
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef adc_calibrate(ADC_HandleTypeDef *hadc)
+{
 #if defined(STM32F0xx) || defined(STM32F1xx) || defined(STM32F3xx) || \
     defined(STM32G0xx) || defined(STM32G4xx) || defined(STM32H7xx) || \
     defined(STM32L0xx) || defined(STM32L4xx) || defined(STM32MP1xx) || \
     defined(STM32WBxx)
-  /*##-2.1- Calibrate ADC then Start the conversion process ####################*/
 #if defined(STM32F0xx) || defined(STM32G0xx) || defined(STM32F1xx) || \
     defined(STM32F373xC) || defined(STM32F378xx)
-  if (HAL_ADCEx_Calibration_Start(&AdcHandle) !=  HAL_OK)
+  return HAL_ADCEx_Calibration_Start(hadc);
 #elif defined (STM32H7xx) || defined(STM32MP1xx)
-  if (HAL_ADCEx_Calibration_Start(&AdcHandle, ADC_CALIB_OFFSET, ADC_SINGLE_ENDED) != HAL_OK)
+  return HAL_ADCEx_Calibration_Start(hadc, ADC_CALIB_OFFSET, ADC_SINGLE_ENDED);
 #else
-  if (HAL_ADCEx_Calibration_Start(&AdcHandle, ADC_SINGLE_ENDED) !=  HAL_OK)
+  return HAL_ADCEx_Calibration_Start(hadc, ADC_SINGLE_ENDED);
 #endif
-  {
+#else
+  UNUSED(hadc);
+  return HAL_OK;
+#endif
+}
+
+/**
+  * @brief  Run a single conversion of a pin
+  * @param  pin : the pin to use
+  * @param  resolution : resolution for converted data: 6/8/10/12/14/16
+  * @retval the value of the adc
+  */
+static uint16_t adc_convert(PinName pin, uint32_t resolution)
+{
+  ADC_HandleTypeDef AdcHandle = {};
+  __IO uint16_t uhADCxConvertedValue = 0;
+  uint32_t samplingTime = ADC_SAMPLINGTIME;
+  uint32_t channel = adc_get_pin_config(pin, &AdcHandle, &samplingTime);
+
+  if (AdcHandle.Instance == NP) {
+    return 0;
+  }
+
+  adc_set_init(&AdcHandle, resolution, samplingTime);
+
+  g_current_pin = pin; /* Needed for HAL_ADC_MspInit*/
+
+  if (HAL_ADC_Init(&AdcHandle) != HAL_OK) {
+    return 0;
+  }
+
+  /*##-2- Configure ADC regular channel ######################################*/
+  if (adc_config_channel(&AdcHandle, channel, samplingTime) != HAL_OK) {
+    /* Channel Configuration Error */
+    return 0;
+  }
+
+  /*##-2.1- Calibrate ADC then Start the conversion process ####################*/
+  if (adc_calibrate(&AdcHandle) != HAL_OK) {
     /* ADC Calibration Error */
     return 0;
   }
-#endif
 
   /*##-3- Start the conversion process ####################*/
   if (HAL_ADC_Start(&AdcHandle) != HAL_OK) {
@@ -1010,50 +1537,971 @@ uint16_t adc_read_value(PinName pin, uint32_t resolution)
 
   return uhADCxConvertedValue;
 }
-#endif /* HAL_ADC_MODULE_ENABLED && !HAL_ADC_MODULE_ONLY*/
-
-#if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
-////////////////////////// PWM INTERFACE FUNCTIONS /////////////////////////////
 
 /**
-  * @brief  This function will set the PWM to the required value
-  * @param  port : the gpio port to use
-  * @param  pin : the gpio pin to use
-  * @param  clock_freq : frequency of the tim clock
-  * @param  value : the value to push on the PWM output
-  * @retval None
+  * @brief  This function will set the ADC to the required value
+  * @param  pin : the pin to use
+  * @param  resolution : resolution for converted data: 6/8/10/12/14/16
+  * @retval the value of the adc
   */
-void pwm_start(PinName pin, uint32_t PWM_freq, uint32_t value, TimerCompareFormat_t resolution)
+uint16_t adc_read_value(PinName pin, uint32_t resolution)
 {
-  TIM_TypeDef *Instance = (TIM_TypeDef *)pinmap_peripheral(pin, PinMap_PWM);
-  HardwareTimer *HT;
-  uint32_t index = get_timer_index(Instance);
-  if (HardwareTimer_Handle[index] == NULL) {
-    HardwareTimer_Handle[index]->__this = new HardwareTimer((TIM_TypeDef *)pinmap_peripheral(pin, PinMap_PWM));
-  }
+#ifdef ADC_WATCHDOG_AVAILABLE
+  uint16_t value;
 
-  HT = (HardwareTimer *)(HardwareTimer_Handle[index]->__this);
+  adc_watchdog_pause(pin);
+  value = adc_convert(pin, resolution);
+  adc_watchdog_resume();
+  return value;
+#else
+  return adc_convert(pin, resolution);
+#endif
+}
 
-  uint32_t channel = STM_PIN_CHANNEL(pinmap_function(pin, PinMap_PWM));
+////////////////////////// ADC ANALOG WATCHDOG /////////////////////////////////
+
+#ifdef ADC_WATCHDOG_AVAILABLE
+typedef struct {
+  ADC_HandleTypeDef handle;     /* Used when the watchdog runs continuous conversions */
+  ADC_HandleTypeDef *hadc;      /* ADC the watchdog is running on, NULL if none */
+  PinName pin;
+  uint32_t resolution;
+  uint32_t low;
+  uint32_t high;
+  adc_watchdog_callback_t callback; /* Set while the watchdog is armed, even if not running */
+} adc_watchdog_t;
+
+static adc_watchdog_t adc_awd = {};
 
-  HT->setMode(channel, TIMER_OUTPUT_COMPARE_PWM1, pin);
-  HT->setOverflow(PWM_freq, HERTZ_FORMAT);
-  HT->setCaptureCompare(channel, value, resolution);
-  HT->resume();
-}
 /**
-  * @brief  This function will disable the PWM
-  * @param  port : the gpio port to use
-  * @param  pin : the gpio pin to use
-  * @retval None
+  * @brief  Configure the analog watchdog 1 on an initialized ADC
+  * @param  hadc : ADC handle
+  * @param  channel : monitored channel
+  * @retval HAL status
   */
-void pwm_stop(PinName pin)
+static HAL_StatusTypeDef adc_watchdog_config(ADC_HandleTypeDef *hadc, uint32_t channel)
 {
-  TIM_TypeDef *Instance = (TIM_TypeDef *)pinmap_peripheral(pin, PinMap_PWM);
-  HardwareTimer *HT;
-  uint32_t index = get_timer_index(Instance);
+  ADC_AnalogWDGConfTypeDef AnalogWDGConfig = {};
+
+#ifdef ADC_ANALOGWATCHDOG_1
+  AnalogWDGConfig.WatchdogNumber = ADC_ANALOGWATCHDOG_1;
+#endif
+  AnalogWDGConfig.WatchdogMode   = ADC_ANALOGWATCHDOG_SINGLE_REG;  /* Monitor a single regular channel */
+  AnalogWDGConfig.Channel        = channel;
+  AnalogWDGConfig.ITMode         = ENABLE;
+  AnalogWDGConfig.HighThreshold  = adc_awd.high;
+  AnalogWDGConfig.LowThreshold   = adc_awd.low;
+#ifdef ADC_AWD_FILTERING_NONE
+  AnalogWDGConfig.FilteringConfig = ADC_AWD_FILTERING_NONE;
+#endif
+  if (HAL_ADC_AnalogWDGConfig(hadc, &AnalogWDGConfig) != HAL_OK) {
+    return HAL_ERROR;
+  }
+  adc_awd.hadc = hadc;
+  HAL_NVIC_SetPriority(ADC_AWD_IRQn, ADC_AWD_IRQ_PRIO, ADC_AWD_IRQ_SUBPRIO);
+  HAL_NVIC_EnableIRQ(ADC_AWD_IRQn);
+  return HAL_OK;
+}
+
+/**
+  * @brief  Convert the watched pin continuously with its own ADC handle
+  * @param  None
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef adc_watchdog_run(void)
+{
+  ADC_HandleTypeDef *hadc = &adc_awd.handle;
+  uint32_t samplingTime = ADC_SAMPLINGTIME;
+  uint32_t channel;
+
+  *hadc = {};
+  channel = adc_get_pin_config(adc_awd.pin, hadc, &samplingTime);
+  if (hadc->Instance == NP) {
+    return HAL_ERROR;
+  }
+
+  adc_set_init(hadc, adc_awd.resolution, samplingTime);
+  hadc->Init.ContinuousConvMode    = ENABLE;                        /* Convert without CPU intervention */
+#ifdef ADC_EOC_SEQ_CONV
+  hadc->Init.EOCSelection          = ADC_EOC_SEQ_CONV;              /* Data is never read: no overrun detection */
+#endif
+
+  g_current_pin = adc_awd.pin; /* Needed for HAL_ADC_MspInit*/
+
+  if ((HAL_ADC_Init(hadc) != HAL_OK) ||
+      (adc_config_channel(hadc, channel, samplingTime) != HAL_OK) ||
+      (adc_calibrate(hadc) != HAL_OK) ||
+      (adc_watchdog_config(hadc, channel) != HAL_OK) ||
+      (HAL_ADC_Start(hadc) != HAL_OK)) {
+    HAL_ADC_DeInit(hadc);
+    adc_awd.hadc = NULL;
+    return HAL_ERROR;
+  }
+  return HAL_OK;
+}
+
+/**
+  * @brief  Stop the continuous conversions run by the watchdog, if any.
+  *         Watchdog settings are kept.
+  * @param  None
+  * @retval None
+  */
+static void adc_watchdog_suspend(void)
+{
+  if (adc_awd.hadc == &adc_awd.handle) {
+    HAL_NVIC_DisableIRQ(ADC_AWD_IRQn);
+    HAL_ADC_Stop(&adc_awd.handle);
+    HAL_ADC_DeInit(&adc_awd.handle);
+  }
+  adc_awd.hadc = NULL;
+}
+
+/**
+  * @brief  Suspend the continuous conversions run by the watchdog before
+  *         the ADC of a pin is initialized, if it disturbs them
+  * @param  pin : pin about to be converted
+  * @retval None
+  */
+static void adc_watchdog_pause(PinName pin)
+{
+  if (adc_awd.hadc != &adc_awd.handle) {
+    return;
+  }
+#if defined(__HAL_RCC_ADC_FORCE_RESET) || defined(__HAL_RCC_ADC12_FORCE_RESET)
+  /* HAL_ADC_MspDeInit() resets more than one ADC */
+  UNUSED(pin);
+#else
+  ADC_HandleTypeDef tmp = {};
+  uint32_t samplingTime = ADC_SAMPLINGTIME;
+
+  adc_get_pin_config(pin, &tmp, &samplingTime);
+  if (tmp.Instance != adc_awd.handle.Instance) {
+    return;
+  }
+#endif
+  adc_watchdog_suspend();
+}
+
+/**
+  * @brief  Run again the continuous conversions of an armed watchdog which
+  *         is not running anymore
+  * @param  None
+  * @retval None
+  */
+static void adc_watchdog_resume(void)
+{
+  if ((adc_awd.callback != NULL) && (adc_awd.hadc == NULL)) {
+    /* Watchdog stays armed on failure, next resume tries again */
+    adc_watchdog_run();
+  }
+}
+
+/**
+  * @brief  Arm the watchdog on a stream ADC if it converts the watched pin
+  * @param  hadc : initialized ADC handle, not converting
+  * @param  pin : the pin converted by hadc
+  * @retval None
+  */
+static void adc_watchdog_attach(ADC_HandleTypeDef *hadc, PinName pin)
+{
+  uint32_t samplingTime = ADC_SAMPLINGTIME;
+  ADC_HandleTypeDef tmp = {};
+
+  if ((adc_awd.callback != NULL) && (adc_awd.hadc == NULL) && (pin == adc_awd.pin)) {
+    adc_watchdog_config(hadc, adc_get_pin_config(pin, &tmp, &samplingTime));
+  }
+}
+
+/**
+  * @brief  Detach the watchdog from a stream ADC being deinitialized, then
+  *         run again its continuous conversions if it is armed
+  * @param  hadc : stream ADC handle
+  * @retval None
+  */
+static void adc_watchdog_detach(ADC_HandleTypeDef *hadc)
+{
+  if (adc_awd.hadc == hadc) {
+    adc_awd.hadc = NULL;
+  }
+  adc_watchdog_resume();
+}
+
+/**
+  * @brief  Arm the ADC analog watchdog on a pin. Each conversion of the pin
+  *         is compared by hardware to the [low, high] window and callback is
+  *         called when a converted value is outside of it.
+  *         If no ADC stream is started, the pin is converted continuously
+  *         without CPU intervention. If adc_stream_start() is called later on
+  *         the same pin, the watchdog monitors the stream conversions instead.
+  * @note   Callback is called from interrupt context, then the watchdog
+  *         interrupt is disabled until adc_watchdog_rearm() is called.
+  *         Continuous conversions are suspended while analogRead() or a
+  *         stream uses the same ADC, and run again afterwards.
+  * @param  pin : the pin to monitor
+  * @param  resolution : resolution for converted data: 6/8/10/12/14/16
+  * @param  low : low threshold, in converted data unit
+  * @param  high : high threshold, in converted data unit
+  * @param  callback : called when a conversion is outside of the window
+  * @retval true if the watchdog is armed, false otherwise
+  */
+bool adc_watchdog_start(PinName pin, uint32_t resolution, uint32_t low,
+                        uint32_t high, adc_watchdog_callback_t callback)
+{
+  ADC_HandleTypeDef tmp = {};
+  uint32_t samplingTime = ADC_SAMPLINGTIME;
+
+  adc_get_pin_config(pin, &tmp, &samplingTime);
+  if ((callback == NULL) || (low > high) ||
+#ifdef ADC2
+      ((tmp.Instance != ADC1) && (tmp.Instance != ADC2))) {
+#else
+      (tmp.Instance != ADC1)) {
+#endif
+    return false;
+  }
+
+  adc_watchdog_suspend();
+  adc_awd.pin = pin;
+  adc_awd.resolution = resolution;
+  adc_awd.low = low;
+  adc_awd.high = high;
+  adc_awd.callback = callback;
+  if (adc_watchdog_run() != HAL_OK) {
+    adc_awd.callback = NULL;
+    return false;
+  }
+  return true;
+}
+
+/**
+  * @brief  Enable again the watchdog interrupt after it has been triggered
+  * @param  None
+  * @retval None
+  */
+void adc_watchdog_rearm(void)
+{
+  if (adc_awd.hadc != NULL) {
+    __HAL_ADC_CLEAR_FLAG(adc_awd.hadc, ADC_FLAG_AWD_USED);
+    __HAL_ADC_ENABLE_IT(adc_awd.hadc, ADC_IT_AWD_USED);
+  }
+}
+
+/**
+  * @brief  Disarm the ADC analog watchdog
+  * @param  None
+  * @retval None
+  */
+void adc_watchdog_stop(void)
+{
+  if ((adc_awd.hadc != NULL) && (adc_awd.hadc != &adc_awd.handle)) {
+    /* Monitoring a stream: only disable the interrupt */
+    __HAL_ADC_DISABLE_IT(adc_awd.hadc, ADC_IT_AWD_USED);
+  }
+  adc_watchdog_suspend();
+  adc_awd.callback = NULL;
+}
+
+/**
+  * @brief  ADC IRQ handler used by the analog watchdog
+  * @note   Weak: a sketch or a library using this ADC interrupt for another
+  *         purpose can define its own handler. The watchdog event is handled
+  *         here so that HAL_ADC_LevelOutOfWindowCallback() stays available.
+  * @param  None
+  * @retval None
+  */
+WEAK void ADC_AWD_IRQHandler(void)
+{
+  ADC_HandleTypeDef *hadc = adc_awd.hadc;
+
+  if (hadc == NULL) {
+    return;
+  }
+  if (__HAL_ADC_GET_FLAG(hadc, ADC_FLAG_AWD_USED) &&
+      __HAL_ADC_GET_IT_SOURCE(hadc, ADC_IT_AWD_USED)) {
+    /* Value stays out of window for many conversions: avoid an interrupt storm */
+    __HAL_ADC_DISABLE_IT(hadc, ADC_IT_AWD_USED);
+    __HAL_ADC_CLEAR_FLAG(hadc, ADC_FLAG_AWD_USED);
+    if (adc_awd.callback != NULL) {
+      adc_awd.callback();
+    }
+  }
+  /* Other events of the ADC, e.g. overrun of a stream */
+  HAL_ADC_IRQHandler(hadc);
+}
+#endif /* ADC_WATCHDOG_AVAILABLE */
+
+#if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
+////////////////////// ADC TIMER TRIGGERED STREAMING ///////////////////////////
+
+/* DMA stream/channel serving the ADC regular data register */
+#if defined(DMA2_Stream0) && !defined(DMAMUX1)
+#define ADC_DMA_INSTANCE        DMA2_Stream0
+#define ADC_DMA_IRQn            DMA2_Stream0_IRQn
+#define ADC_DMA_IRQHandler      DMA2_Stream0_IRQHandler
+#elif defined(DMA1_Stream0)
+#define ADC_DMA_INSTANCE        DMA1_Stream0
+#define ADC_DMA_IRQn            DMA1_Stream0_IRQn
+#define ADC_DMA_IRQHandler      DMA1_Stream0_IRQHandler
+#elif defined(DMA1_Channel1)
+#define ADC_DMA_INSTANCE        DMA1_Channel1
+#define ADC_DMA_IRQn            DMA1_Channel1_IRQn
+#define ADC_DMA_IRQHandler      DMA1_Channel1_IRQHandler
+#endif
+
+#ifndef ADC_DMA_IRQ_PRIO
+#define ADC_DMA_IRQ_PRIO        1
+#endif
+#ifndef ADC_DMA_IRQ_SUBPRIO
+#define ADC_DMA_IRQ_SUBPRIO     0
+#endif
+
+#ifdef ADC_DMA_INSTANCE
+typedef struct {
+  ADC_HandleTypeDef handle;     /* Single ADC or multimode master */
+#ifdef ADC_DUAL_MODE_AVAILABLE
+  ADC_HandleTypeDef slave;      /* Multimode slave */
+#endif
+  DMA_HandleTypeDef hdma;
+  HardwareTimer *timer;
+  uint16_t *buffer;
+  uint32_t *dual_buffer;
+  uint32_t length;
+  adc_stream_callback_t callback;
+  adc_dual_stream_callback_t dual_callback;
+} adc_stream_t;
+
+static adc_stream_t adc_stream = {};
+
+/**
+  * @brief  Retrieve the ADC external trigger matching a timer TRGO
+  * @param  tim : timer instance
+  * @retval ADC external trigger or ADC_SOFTWARE_START if not supported
+  */
+static uint32_t get_adc_trigger(TIM_TypeDef *tim)
+{
+  uint32_t trigger = ADC_SOFTWARE_START;
+
+  if (tim == NP) {
+    return trigger;
+  }
+#if defined(TIM1)
+  else if (tim == TIM1) {
+#if defined(ADC_EXTERNALTRIGCONV_T1_TRGO)
+    trigger = ADC_EXTERNALTRIGCONV_T1_TRGO;
+#elif defined(ADC_EXTERNALTRIG_T1_TRGO)
+    trigger = ADC_EXTERNALTRIG_T1_TRGO;
+#endif
+  }
+#endif
+#if defined(TIM2)
+  else if (tim == TIM2) {
+#if defined(ADC_EXTERNALTRIGCONV_T2_TRGO)
+    trigger = ADC_EXTERNALTRIGCONV_T2_TRGO;
+#elif defined(ADC_EXTERNALTRIG_T2_TRGO)
+    trigger = ADC_EXTERNALTRIG_T2_TRGO;
+#endif
+  }
+#endif
+#if defined(TIM3)
+  else if (tim == TIM3) {
+#if defined(ADC_EXTERNALTRIGCONV_T3_TRGO)
+    trigger = ADC_EXTERNALTRIGCONV_T3_TRGO;
+#elif defined(ADC_EXTERNALTRIG_T3_TRGO)
+    trigger = ADC_EXTERNALTRIG_T3_TRGO;
+#endif
+  }
+#endif
+#if defined(TIM4)
+  else if (tim == TIM4) {
+#if defined(ADC_EXTERNALTRIGCONV_T4_TRGO)
+    trigger = ADC_EXTERNALTRIGCONV_T4_TRGO;
+#elif defined(ADC_EXTERNALTRIG_T4_TRGO)
+    trigger = ADC_EXTERNALTRIG_T4_TRGO;
+#endif
+  }
+#endif
+#if defined(TIM6)
+  else if (tim == TIM6) {
+#if defined(ADC_EXTERNALTRIGCONV_T6_TRGO)
+    trigger = ADC_EXTERNALTRIGCONV_T6_TRGO;
+#elif defined(ADC_EXTERNALTRIG_T6_TRGO)
+    trigger = ADC_EXTERNALTRIG_T6_TRGO;
+#endif
+  }
+#endif
+#if defined(TIM8)
+  else if (tim == TIM8) {
+#if defined(ADC_EXTERNALTRIGCONV_T8_TRGO)
+    trigger = ADC_EXTERNALTRIGCONV_T8_TRGO;
+#elif defined(ADC_EXTERNALTRIG_T8_TRGO)
+    trigger = ADC_EXTERNALTRIG_T8_TRGO;
+#endif
+  }
+#endif
+#if defined(TIM15)
+  else if (tim == TIM15) {
+#if defined(ADC_EXTERNALTRIGCONV_T15_TRGO)
+    trigger = ADC_EXTERNALTRIGCONV_T15_TRGO;
+#elif defined(ADC_EXTERNALTRIG_T15_TRGO)
+    trigger = ADC_EXTERNALTRIG_T15_TRGO;
+#endif
+  }
+#endif
+#if defined(TIM21)
+  else if (tim == TIM21) {
+#if defined(ADC_EXTERNALTRIGCONV_T21_TRGO)
+    trigger = ADC_EXTERNALTRIGCONV_T21_TRGO;
+#endif
+  }
+#endif
+#if defined(TIM22)
+  else if (tim == TIM22) {
+#if defined(ADC_EXTERNALTRIGCONV_T22_TRGO)
+    trigger = ADC_EXTERNALTRIGCONV_T22_TRGO;
+#endif
+  }
+#endif
+  return trigger;
+}
+
+/**
+  * @brief  Configure the DMA used to transfer ADC conversions in circular mode
+  * @param  hadc : ADC handle
+  * @param  hdma : DMA handle
+  * @param  word : true to transfer 32-bit words (multimode common data
+  *                register), false to transfer half-words
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef adc_dma_init(ADC_HandleTypeDef *hadc, DMA_HandleTypeDef *hdma, bool word)
+{
+#if defined(DMA2_Stream0) && !defined(DMAMUX1)
+  __HAL_RCC_DMA2_CLK_ENABLE();
+  if (hadc->Instance == ADC1) {
+    hdma->Init.Channel           = DMA_CHANNEL_0;
+  }
+#ifdef ADC3
+  else if (hadc->Instance == ADC3) {
+    hdma->Init.Channel           = DMA_CHANNEL_2;
+  }
+#endif
+  else {
+    /* ADC not connected to this DMA stream */
+    return HAL_ERROR;
+  }
+#else
+  __HAL_RCC_DMA1_CLK_ENABLE();
+#ifdef __HAL_RCC_DMAMUX1_CLK_ENABLE
+  __HAL_RCC_DMAMUX1_CLK_ENABLE();
+#endif
+#if defined(DMAMUX1)
+  if (hadc->Instance == ADC1) {
+    hdma->Init.Request           = DMA_REQUEST_ADC1;
+  }
+#if defined(ADC2) && defined(DMA_REQUEST_ADC2)
+  else if (hadc->Instance == ADC2) {
+    hdma->Init.Request           = DMA_REQUEST_ADC2;
+  }
+#endif
+#if defined(ADC3) && defined(DMA_REQUEST_ADC3)
+  else if (hadc->Instance == ADC3) {
+    hdma->Init.Request           = DMA_REQUEST_ADC3;
+  }
+#endif
+  else {
+    /* No DMA request available for this ADC */
+    return HAL_ERROR;
+  }
+#else
+  if (hadc->Instance != ADC1) {
+    /* ADC not connected to this DMA channel */
+    return HAL_ERROR;
+  }
+#if defined(DMA_REQUEST_0)
+  hdma->Init.Request             = DMA_REQUEST_0;
+#endif
+#endif /* DMAMUX1 */
+#endif /* DMA2_Stream0 && !DMAMUX1 */
+
+  hdma->Instance                 = ADC_DMA_INSTANCE;
+  if (!acquireDma(hdma)) {
+    /* Stream/channel used by a timer */
+    return HAL_ERROR;
+  }
+  hdma->Init.Direction           = DMA_PERIPH_TO_MEMORY;
+  hdma->Init.PeriphInc           = DMA_PINC_DISABLE;
+  hdma->Init.MemInc              = DMA_MINC_ENABLE;
+  hdma->Init.PeriphDataAlignment = (word) ? DMA_PDATAALIGN_WORD : DMA_PDATAALIGN_HALFWORD;
+  hdma->Init.MemDataAlignment    = (word) ? DMA_MDATAALIGN_WORD : DMA_MDATAALIGN_HALFWORD;
+  hdma->Init.Mode                = DMA_CIRCULAR;
+  hdma->Init.Priority            = DMA_PRIORITY_HIGH;
+#if defined(DMA_FIFOMODE_DISABLE)
+  hdma->Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+#endif
+
+  if (HAL_DMA_Init(hdma) != HAL_OK) {
+    releaseDma(hdma);
+    return HAL_ERROR;
+  }
+  __HAL_LINKDMA(hadc, DMA_Handle, *hdma);
+
+  HAL_NVIC_SetPriority(ADC_DMA_IRQn, ADC_DMA_IRQ_PRIO, ADC_DMA_IRQ_SUBPRIO);
+  HAL_NVIC_EnableIRQ(ADC_DMA_IRQn);
+  return HAL_OK;
+}
+
+/**
+  * @brief  DMA half-transfer callback of the ADC stream
+  * @note   Installed on the DMA handle in place of the HAL ADC one, so that
+  *         HAL_ADC_ConvHalfCpltCallback() stays available to the user
+  * @param  hdma: DMA handle
+  * @retval None
+  */
+static void adc_stream_half_cplt(DMA_HandleTypeDef *hdma)
+{
+  UNUSED(hdma);
+  if (adc_stream.callback != NULL) {
+    adc_stream.callback(adc_stream.buffer, adc_stream.length / 2);
+  } else if (adc_stream.dual_callback != NULL) {
+    adc_stream.dual_callback(adc_stream.dual_buffer, adc_stream.length / 2);
+  }
+}
+
+/**
+  * @brief  DMA transfer complete callback of the ADC stream
+  * @note   Installed on the DMA handle in place of the HAL ADC one, so that
+  *         HAL_ADC_ConvCpltCallback() stays available to the user
+  * @param  hdma: DMA handle
+  * @retval None
+  */
+static void adc_stream_cplt(DMA_HandleTypeDef *hdma)
+{
+  UNUSED(hdma);
+  if (adc_stream.callback != NULL) {
+    adc_stream.callback(adc_stream.buffer + (adc_stream.length / 2), adc_stream.length / 2);
+  } else if (adc_stream.dual_callback != NULL) {
+    adc_stream.dual_callback(adc_stream.dual_buffer + (adc_stream.length / 2), adc_stream.length / 2);
+  }
+}
+
+/**
+  * @brief  Initialize an ADC for conversions triggered by a timer TRGO
+  * @param  hadc : ADC handle
+  * @param  pin : the pin to sample
+  * @param  resolution : resolution for converted data: 6/8/10/12/14/16
+  * @param  trigger : ADC external trigger, ADC_SOFTWARE_START for a
+  *                   multimode slave
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef adc_stream_init(ADC_HandleTypeDef *hadc, PinName pin,
+                                         uint32_t resolution, uint32_t trigger)
+{
+  uint32_t samplingTime = ADC_SAMPLINGTIME;
+  uint32_t channel;
+
+  *hadc = {};
+  channel = adc_get_pin_config(pin, hadc, &samplingTime);
+  if (hadc->Instance == NP) {
+    return HAL_ERROR;
+  }
+
+  adc_set_init(hadc, resolution, samplingTime);
+  hadc->Init.ExternalTrigConv      = trigger;                       /* Conversion triggered by timer TRGO */
+#if !defined(STM32F1xx) && !defined(STM32F373xC) && !defined(STM32F378xx)
+  if (trigger != ADC_SOFTWARE_START) {
+    hadc->Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_RISING;
+  }
+#endif
+#if !defined(STM32F1xx) && !defined(STM32H7xx) && !defined(STM32MP1xx) && \
+    !defined(STM32F373xC) && !defined(STM32F378xx)
+  hadc->Init.DMAContinuousRequests = ENABLE;                        /* DMA circular mode */
+#endif
+#ifdef ADC_CONVERSIONDATA_DMA_CIRCULAR
+  hadc->Init.ConversionDataManagement = ADC_CONVERSIONDATA_DMA_CIRCULAR;
+#endif
+
+  g_current_pin = pin; /* Needed for HAL_ADC_MspInit*/
+
+  if ((HAL_ADC_Init(hadc) != HAL_OK) ||
+      (adc_config_channel(hadc, channel, samplingTime) != HAL_OK)) {
+    HAL_ADC_DeInit(hadc);
+    return HAL_ERROR;
+  }
+  return HAL_OK;
+}
+
+/**
+  * @brief  Start continuous ADC sampling of a pin, triggered by a timer.
+  *         Conversions are transferred by DMA in circular mode into buffer,
+  *         used as a double buffer: callback is called each time one half of
+  *         it has been filled, with the address of this half and its length.
+  *         Only one stream can be active at a time.
+  * @note   Callback is called from DMA interrupt context. The half handed to
+  *         the callback is overwritten once the other half is filled.
+  * @param  pin : the pin to sample
+  * @param  resolution : resolution for converted data: 6/8/10/12/14/16
+  * @param  tim : timer instance which TRGO triggers the conversions, not
+  *               used by anything else. It is released when the stream is stopped
+  * @param  frequency : sampling frequency in Hz
+  * @param  buffer : samples buffer
+  * @param  length : number of samples in buffer (even number)
+  * @param  callback : called each time one half of buffer is filled
+  * @retval true if the stream is started, false otherwise
+  */
+bool adc_stream_start(PinName pin, uint32_t resolution, TIM_TypeDef *tim,
+                      uint32_t frequency, uint16_t *buffer, uint32_t length,
+                      adc_stream_callback_t callback)
+{
+  ADC_HandleTypeDef *hadc = &adc_stream.handle;
+  uint32_t trigger = get_adc_trigger(tim);
+
+  if ((adc_stream.timer != NULL) || (buffer == NULL) || (length < 2) ||
+      (frequency == 0) || (trigger == ADC_SOFTWARE_START) || !trgo_timer_available(tim)) {
+    return false;
+  }
+
+  adc_stream.hdma = {};
+#ifdef ADC_WATCHDOG_AVAILABLE
+  adc_watchdog_pause(pin);
+#endif
+  if (adc_stream_init(hadc, pin, resolution, trigger) != HAL_OK) {
+#ifdef ADC_WATCHDOG_AVAILABLE
+    adc_watchdog_detach(hadc);
+#endif
+    return false;
+  }
+  if ((adc_calibrate(hadc) != HAL_OK) ||
+      (adc_dma_init(hadc, &adc_stream.hdma, false) != HAL_OK)) {
+    HAL_ADC_DeInit(hadc);
+#ifdef ADC_WATCHDOG_AVAILABLE
+    adc_watchdog_detach(hadc);
+#endif
+    return false;
+  }
+#ifdef ADC_WATCHDOG_AVAILABLE
+  adc_watchdog_attach(hadc, pin);
+#endif
+
+  adc_stream.buffer = buffer;
+  adc_stream.length = length & ~1UL;
+  adc_stream.callback = callback;
+  adc_stream.dual_callback = NULL;
+
+  if (HAL_ADC_Start_DMA(hadc, (uint32_t *)buffer, adc_stream.length) != HAL_OK) {
+    HAL_DMA_DeInit(&adc_stream.hdma);
+    releaseDma(&adc_stream.hdma);
+    HAL_ADC_DeInit(hadc);
+#ifdef ADC_WATCHDOG_AVAILABLE
+    adc_watchdog_detach(hadc);
+#endif
+    return false;
+  }
+  /* No conversion until the timer is started */
+  adc_stream.hdma.XferHalfCpltCallback = adc_stream_half_cplt;
+  adc_stream.hdma.XferCpltCallback = adc_stream_cplt;
+
+  adc_stream.timer = trgo_timer_start(tim, frequency);
+  return true;
+}
+
+#ifdef ADC_DUAL_MODE_AVAILABLE
+/**
+  * @brief  Start dual ADC sampling of two pins, triggered by a timer.
+  *         pin is converted by ADC1 (master) and pin2 by ADC2 (slave), either
+  *         at the same time or interleaved. Each trigger produces one 32-bit
+  *         word in the common data register format: master conversion in the
+  *         lower half-word, slave conversion in the upper half-word.
+  *         buffer is a double buffer, as for adc_stream_start().
+  * @note   To sample the same pin on both ADCs (interleaved), use the
+  *         ALTx pin name mapped on ADC2 for pin2, e.g. PA_0 and PA_0_ALT1.
+  * @param  pin : the pin converted by ADC1
+  * @param  pin2 : the pin converted by ADC2
+  * @param  mode : ADC_DUAL_SIMULTANEOUS or ADC_DUAL_INTERLEAVED
+  * @param  resolution : resolution for converted data: 6/8/10/12/14/16
+  * @param  tim : timer instance which TRGO triggers the conversions, not
+  *               used by anything else. It is released when the stream is stopped
+  * @param  frequency : trigger frequency in Hz
+  * @param  buffer : samples buffer
+  * @param  length : number of 32-bit samples in buffer (even number)
+  * @param  callback : called each time one half of buffer is filled
+  * @retval true if the stream is started, false otherwise
+  */
+bool adc_dual_stream_start(PinName pin, PinName pin2, adc_dual_mode_t mode,
+                           uint32_t resolution, TIM_TypeDef *tim,
+                           uint32_t frequency, uint32_t *buffer, uint32_t length,
+                           adc_dual_stream_callback_t callback)
+{
+  ADC_HandleTypeDef *hadc = &adc_stream.handle;
+  ADC_HandleTypeDef *hslave = &adc_stream.slave;
+  ADC_MultiModeTypeDef multimode = {};
+  uint32_t trigger = get_adc_trigger(tim);
+
+  if ((adc_stream.timer != NULL) || (buffer == NULL) || (length < 2) ||
+      (frequency == 0) || (trigger == ADC_SOFTWARE_START) || !trgo_timer_available(tim)) {
+    return false;
+  }
+  if ((pinmap_peripheral(pin, PinMap_ADC) != ADC1) ||
+      (pinmap_peripheral(pin2, PinMap_ADC) != ADC2)) {
+    return false;
+  }
+
+  adc_stream.hdma = {};
+#ifdef ADC_WATCHDOG_AVAILABLE
+  adc_watchdog_pause(pin);
+  adc_watchdog_pause(pin2);
+#endif
+  if (adc_stream_init(hadc, pin, resolution, trigger) != HAL_OK) {
+#ifdef ADC_WATCHDOG_AVAILABLE
+    adc_watchdog_detach(hadc);
+#endif
+    return false;
+  }
+  if (adc_stream_init(hslave, pin2, resolution, ADC_SOFTWARE_START) != HAL_OK) {
+    HAL_ADC_DeInit(hadc);
+#ifdef ADC_WATCHDOG_AVAILABLE
+    adc_watchdog_detach(hadc);
+#endif
+    return false;
+  }
+
+  multimode.Mode = (mode == ADC_DUAL_INTERLEAVED) ? ADC_DUALMODE_INTERL : ADC_DUALMODE_REGSIMULT;
+#if defined(ADC_DUALMODEDATAFORMAT_32_10_BITS)
+  multimode.DualModeData = ADC_DUALMODEDATAFORMAT_32_10_BITS;
+#elif defined(ADC_DMAACCESSMODE_12_10_BITS)
+  multimode.DMAAccessMode = ADC_DMAACCESSMODE_12_10_BITS;
+#else
+  multimode.DMAAccessMode = ADC_DMAACCESSMODE_2;
+#endif
+  multimode.TwoSamplingDelay = ADC_TWOSAMPLINGDELAY_5CYCLES;
+
+  if ((HAL_ADCEx_MultiModeConfigChannel(hadc, &multimode) != HAL_OK) ||
+      (adc_calibrate(hadc) != HAL_OK) || (adc_calibrate(hslave) != HAL_OK) ||
+      (adc_dma_init(hadc, &adc_stream.hdma, true) != HAL_OK)) {
+    HAL_ADC_DeInit(hslave);
+    HAL_ADC_DeInit(hadc);
+#ifdef ADC_WATCHDOG_AVAILABLE
+    adc_watchdog_detach(hadc);
+#endif
+    return false;
+  }
+#ifdef ADC_WATCHDOG_AVAILABLE
+  adc_watchdog_attach(hadc, pin);
+#endif
+
+  adc_stream.buffer = NULL;
+  adc_stream.dual_buffer = buffer;
+  adc_stream.length = length & ~1UL;
+  adc_stream.callback = NULL;
+  adc_stream.dual_callback = callback;
+
+#if defined(ADC_DMAACCESSMODE_2)
+  /* Slave ADC has to be enabled, its conversions are started by the master */
+  HAL_ADC_Start(hslave);
+#endif
+  if (HAL_ADCEx_MultiModeStart_DMA(hadc, buffer, adc_stream.length) != HAL_OK) {
+    HAL_DMA_DeInit(&adc_stream.hdma);
+    releaseDma(&adc_stream.hdma);
+    HAL_ADC_DeInit(hslave);
+    HAL_ADC_DeInit(hadc);
+#ifdef ADC_WATCHDOG_AVAILABLE
+    adc_watchdog_detach(hadc);
+#endif
+    return false;
+  }
+  /* No conversion until the timer is started */
+  adc_stream.hdma.XferHalfCpltCallback = adc_stream_half_cplt;
+  adc_stream.hdma.XferCpltCallback = adc_stream_cplt;
+
+  adc_stream.timer = trgo_timer_start(tim, frequency);
+  return true;
+}
+#endif /* ADC_DUAL_MODE_AVAILABLE */
+
+/**
+  * @brief  Stop the ADC stream started by adc_stream_start() or
+  *         adc_dual_stream_start()
+  * @param  None
+  * @retval None
+  */
+void adc_stream_stop(void)
+{
+  ADC_HandleTypeDef *hadc = &adc_stream.handle;
+
+  if (adc_stream.timer == NULL) {
+    return;
+  }
+  HAL_TIM_Base_Stop(adc_stream.timer->getHandle());
+  delete adc_stream.timer;
+  adc_stream.timer = NULL;
+
+#ifdef ADC_DUAL_MODE_AVAILABLE
+  if (adc_stream.dual_callback != NULL) {
+    ADC_MultiModeTypeDef multimode = {};
+
+    HAL_ADCEx_MultiModeStop_DMA(hadc);
+    multimode.Mode = ADC_MODE_INDEPENDENT;
+    HAL_ADCEx_MultiModeConfigChannel(hadc, &multimode);
+    HAL_ADC_DeInit(&adc_stream.slave);
+  } else
+#endif
+  {
+    HAL_ADC_Stop_DMA(hadc);
+  }
+  HAL_NVIC_DisableIRQ(ADC_DMA_IRQn);
+  HAL_DMA_DeInit(&adc_stream.hdma);
+  releaseDma(&adc_stream.hdma);
+  HAL_ADC_DeInit(hadc);
+  adc_stream.callback = NULL;
+  adc_stream.dual_callback = NULL;
+#ifdef ADC_WATCHDOG_AVAILABLE
+  /* Watchdog goes back to continuous conversions */
+  adc_watchdog_detach(hadc);
+#endif
+}
+
+/**
+  * @brief  DMA IRQ handler used by the ADC stream
+  * @note   Weak: a sketch or a library using this DMA stream/channel for
+  *         another purpose can define its own handler
+  * @param  None
+  * @retval None
+  */
+WEAK void ADC_DMA_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&adc_stream.hdma);
+}
+#endif /* ADC_DMA_INSTANCE */
+#endif /* HAL_TIM_MODULE_ENABLED && !HAL_TIM_MODULE_ONLY */
+#endif /* HAL_ADC_MODULE_ENABLED && !HAL_ADC_MODULE_ONLY*/
+
+#if defined(HAL_TIM_MODULE_ENABLED) && !defined(HAL_TIM_MODULE_ONLY)
+////////////////////////// PWM INTERFACE FUNCTIONS /////////////////////////////
+
+/* Running PWM pins: ((timer index + 1) << 3) | channel, 0 if not running */
+#define PWM_CACHE_CHANNEL_MASK  0x07
+#define PWM_CACHE_INDEX_SHIFT   3
+static uint8_t pwm_pin_cache[MAX_NB_PORT][16] = {};
+
+/**
+  * @brief  Return the cache entry of a pin
+  * @param  pin : the gpio pin
+  * @retval cache entry address or NULL if pin is invalid
+  */
+static inline uint8_t *pwm_cache_entry(PinName pin)
+{
+  uint32_t port = STM_PORT(pin) - FirstPort;
+  return (port < MAX_NB_PORT) ? &pwm_pin_cache[port][STM_PIN(pin)] : NULL;
+}
+
+/**
+  * @brief  This function will set the PWM to the required value
+  * @note   Nothing is done while the timer of the pin generates a tone
+  * @param  port : the gpio port to use
+  * @param  pin : the gpio pin to use
+  * @param  clock_freq : frequency of the tim clock
+  * @param  value : the value to push on the PWM output
+  * @retval None
+  */
+void pwm_start(PinName pin, uint32_t PWM_freq, uint32_t value, TimerCompareFormat_t resolution)
+{
+  TIM_TypeDef *Instance = (TIM_TypeDef *)pinmap_peripheral(pin, PinMap_PWM);
+  HardwareTimer *HT;
+  uint8_t *entry = pwm_cache_entry(pin);
+  uint32_t index = get_timer_index(Instance);
+  if ((Instance == NP) || (entry == NULL) || isTimerUsedByTone(Instance)) {
+    /* Timer generates a tone, see noTone() */
+    return;
+  }
   if (HardwareTimer_Handle[index] == NULL) {
-    HardwareTimer_Handle[index]->__this = new HardwareTimer((TIM_TypeDef *)pinmap_peripheral(pin, PinMap_PWM));
+    HT = new HardwareTimer(Instance);
+  } else {
+    HT = (HardwareTimer *)(HardwareTimer_Handle[index]->__this);
+  }
+
+  uint32_t channel = STM_PIN_CHANNEL(pinmap_function(pin, PinMap_PWM));
+
+  if (*entry != (((index + 1) << PWM_CACHE_INDEX_SHIFT) | channel)) {
+    HT->setMode(channel, TIMER_OUTPUT_COMPARE_PWM1, pin);
+    HT->setOverflow(PWM_freq, HERTZ_FORMAT);
+    HT->setCaptureCompare(channel, value, resolution);
+    HT->resume();
+    *entry = ((index + 1) << PWM_CACHE_INDEX_SHIFT) | channel;
+  } else {
+    /* Already running: only update what changed */
+    if (HT->getOverflow(HERTZ_FORMAT) != PWM_freq) {
+      HT->setOverflow(PWM_freq, HERTZ_FORMAT);
+    }
+    HT->setCaptureCompare(channel, value, resolution);
+  }
+}
+
+/**
+  * @brief  Update the duty cycle of a PWM pin already started by
+  *         pwm_start(), with a single compare register write.
+  * @param  pin : the gpio pin
+  * @param  value : the value to push on the PWM output
+  * @param  resolution : resolution of value (RESOLUTION_xB_COMPARE_FORMAT)
+  * @retval true if the pin was running, false otherwise
+  */
+bool pwm_update(PinName pin, uint32_t value, TimerCompareFormat_t resolution)
+{
+  uint8_t *entry = pwm_cache_entry(pin);
+  uint32_t index;
+  TIM_TypeDef *Instance;
+
+  if ((entry == NULL) || (*entry == 0) ||
+      (resolution < RESOLUTION_1B_COMPARE_FORMAT) || (resolution > RESOLUTION_16B_COMPARE_FORMAT)) {
+    return false;
+  }
+  index = (*entry >> PWM_CACHE_INDEX_SHIFT) - 1;
+  if (HardwareTimer_Handle[index] == NULL) {
+    /* Timer has been released since */
+    *entry = 0;
+    return false;
+  }
+  Instance = HardwareTimer_Handle[index]->handle.Instance;
+  /* Same conversion as HardwareTimer::setCaptureCompare(), CCR1..CCR4 are contiguous */
+  (&Instance->CCR1)[(*entry & PWM_CACHE_CHANNEL_MASK) - 1] =
+    ((Instance->ARR + 1) * value) / ((1 << resolution) - 1);
+  return true;
+}
+
+/**
+  * @brief  Forget running PWM pins, next pwm_start() call of each pin fully
+  *         configures its timer channel again
+  * @param  None
+  * @retval None
+  */
+void pwm_cache_clear(void)
+{
+  for (uint32_t port = 0; port < MAX_NB_PORT; port++) {
+    for (uint32_t i = 0; i < 16; i++) {
+      pwm_pin_cache[port][i] = 0;
+    }
+  }
+}
+
+/**
+  * @brief  This function will disable the PWM
+  * @param  port : the gpio port to use
+  * @param  pin : the gpio pin to use
+  * @retval None
+  */
+void pwm_stop(PinName pin)
+{
+  TIM_TypeDef *Instance = (TIM_TypeDef *)pinmap_peripheral(pin, PinMap_PWM);
+  HardwareTimer *HT;
+  uint32_t index = get_timer_index(Instance);
+  if ((Instance == NP) || (HardwareTimer_Handle[index] == NULL)) {
+    return;
+  }
+
+  /* All channels of the timer are stopped */
+  for (uint32_t port = 0; port < MAX_NB_PORT; port++) {
+    for (uint32_t i = 0; i < 16; i++) {
+      if ((pwm_pin_cache[port][i] >> PWM_CACHE_INDEX_SHIFT) == (index + 1)) {
+        pwm_pin_cache[port][i] = 0;
+      }
+    }
   }
 
   HT = (HardwareTimer *)(HardwareTimer_Handle[index]->__this);
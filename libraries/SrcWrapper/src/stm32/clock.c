@@ -53,6 +53,166 @@ __STATIC_INLINE uint32_t LL_SYSTICK_IsActiveCounterFlag(void)
 }
 #endif
 
+#if defined(TICKLESS_TIMER)
+/**
+  * @brief  Function called to read the current micro second, never wraps
+  * @note   Time base is the TICKLESS_TIMER free running counter
+  * @param  None
+  * @retval Microseconds since start
+  */
+uint64_t getCurrentMicros64(void)
+{
+  return timebaseGetMicros64();
+}
+
+/**
+  * @brief  Function called to read the current nano second, never wraps
+  * @note   Resolution is one microsecond
+  * @param  None
+  * @retval Nanoseconds since start
+  */
+uint64_t getCurrentNanos64(void)
+{
+  return timebaseGetMicros64() * 1000;
+}
+
+/**
+  * @brief  Function called to read the current millisecond, never wraps
+  * @param  None
+  * @retval Milliseconds since start
+  */
+uint64_t getCurrentMillis64(void)
+{
+  return timebaseGetMicros64() / 1000;
+}
+
+#else /* !TICKLESS_TIMER */
+
+/* Milliseconds per SysTick interrupt, can be increased with HAL_SetTickFreq() */
+#if defined(STM32F1xx)
+/* Not exported by HAL header */
+extern __IO uint32_t uwTick;
+#endif
+#if defined(STM32L0xx)
+#define TICK_PERIOD_MS  1U
+#else
+#define TICK_PERIOD_MS  ((uint32_t)HAL_GetTickFreq())
+#endif
+
+/* Milliseconds counted by SysTick interrupts since start, extended to 64 bits */
+static volatile uint64_t tickCount64 = 0;
+/* Last value returned by getCurrentTime(), to stay monotonic */
+static uint64_t lastTickCount = 0;
+static uint32_t lastElapsed = 0;
+
+/**
+  * @brief  Read milliseconds counted by SysTick interrupts and SysTick clocks
+  *         elapsed since last one
+  * @note   Can be called from any interrupt priority: a SysTick interrupt pending
+  *         but not handled yet is taken into account.
+  * @param  elapsed: SysTick clocks elapsed in current period [0..LOAD]
+  * @param  period: SysTick clocks per period (LOAD + 1)
+  * @retval Milliseconds at the beginning of current period
+  */
+static uint64_t getCurrentTime(uint32_t *elapsed, uint32_t *period)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  uint64_t count = tickCount64;
+  uint32_t load = SysTick->LOAD;
+  uint32_t val = SysTick->VAL;
+  if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) {
+    /* Counter reloaded before or after VAL was read: read it again */
+    count += TICK_PERIOD_MS;
+    val = SysTick->VAL;
+    val = (val != 0) ? val : load;
+  }
+  uint32_t ticks = load - val;
+
+  /* Interrupt of higher priority preempting SysTick_Handler before its update */
+  if ((count < lastTickCount) || ((count == lastTickCount) && (ticks < lastElapsed))) {
+    count = lastTickCount;
+    ticks = lastElapsed;
+  }
+  lastTickCount = count;
+  lastElapsed = ticks;
+
+  __set_PRIMASK(primask);
+  *elapsed = ticks;
+  *period = load + 1;
+  return count;
+}
+
+/**
+  * @brief  Convert SysTick clocks elapsed in current period to time units
+  * @param  elapsed: SysTick clocks elapsed in current period
+  * @param  period: SysTick clocks per period
+  * @param  units: time units per period
+  * @retval elapsed * units / period
+  */
+static inline uint32_t getTickFraction(uint32_t elapsed, uint32_t period, uint32_t units)
+{
+  uint64_t product = (uint64_t)elapsed * units;
+  /* 32-bit division whenever possible */
+  if ((product >> 32) == 0) {
+    return (uint32_t)product / period;
+  }
+  return (uint32_t)(product / period);
+}
+
+/**
+  * @brief  Function called to read the current micro second, never wraps
+  * @param  None
+  * @retval Microseconds since start
+  */
+uint64_t getCurrentMicros64(void)
+{
+  uint32_t elapsed, period;
+  uint64_t ms = getCurrentTime(&elapsed, &period);
+  return (ms * 1000) + getTickFraction(elapsed, period, TICK_PERIOD_MS * 1000);
+}
+
+/**
+  * @brief  Function called to read the current nano second, never wraps
+  * @note   Resolution is one SysTick clock
+  * @param  None
+  * @retval Nanoseconds since start
+  */
+uint64_t getCurrentNanos64(void)
+{
+  uint32_t elapsed, period;
+  uint64_t ms = getCurrentTime(&elapsed, &period);
+  return (ms * 1000000) + getTickFraction(elapsed, period, TICK_PERIOD_MS * 1000000);
+}
+
+/**
+  * @brief  Function called to read the current millisecond, never wraps
+  * @param  None
+  * @retval Milliseconds since start
+  */
+uint64_t getCurrentMillis64(void)
+{
+  uint32_t elapsed, period;
+  uint64_t ms = getCurrentTime(&elapsed, &period);
+  return ms + getTickFraction(elapsed, period, TICK_PERIOD_MS);
+}
+
+/**
+  * @brief  Provide a tick value in millisecond, used by HAL timeouts
+  * @note   With a SysTick period longer than 1 ms, HAL tick would only count
+  *         whole periods: time elapsed in current period is added
+  * @retval tick value
+  */
+uint32_t HAL_GetTick(void)
+{
+  if (TICK_PERIOD_MS != 1) {
+    return (uint32_t)getCurrentMillis64();
+  }
+  return uwTick;
+}
+#endif /* TICKLESS_TIMER */
+
 /**
   * @brief  Function called to read the current micro second
   * @param  None
@@ -60,16 +220,7 @@ __STATIC_INLINE uint32_t LL_SYSTICK_IsActiveCounterFlag(void)
   */
 uint32_t getCurrentMicros(void)
 {
-  /* Ensure COUNTFLAG is reset by reading SysTick control and status register */
-  LL_SYSTICK_IsActiveCounterFlag();
-  uint32_t m = HAL_GetTick();
-  const uint32_t tms = SysTick->LOAD + 1;
-  __IO uint32_t u = tms - SysTick->VAL;
-  if (LL_SYSTICK_IsActiveCounterFlag()) {
-    m = HAL_GetTick();
-    u = tms - SysTick->VAL;
-  }
-  return (m * 1000 + (u * 1000) / tms);
+  return (uint32_t)getCurrentMicros64();
 }
 
 /**
@@ -95,6 +246,14 @@ void osSystickHandler() __attribute__((weak, alias("noOsSystickHandler")));
   */
 void SysTick_Handler(void)
 {
+#if !defined(TICKLESS_TIMER)
+  /* 64-bit update must not be seen half done by a higher priority interrupt */
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  tickCount64 += TICK_PERIOD_MS;
+  __set_PRIMASK(primask);
+#endif
+
   HAL_IncTick();
   HAL_SYSTICK_IRQHandler();
   osSystickHandler();
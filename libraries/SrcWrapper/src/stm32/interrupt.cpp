@@ -46,65 +46,72 @@
 /*As we can have only one interrupt/pin id, don't need to get the port info*/
 typedef struct {
   IRQn_Type irqnb;
-  std::function<void(void)> callback;
+  void (*volatile handler)(void *);  // called from interrupt with arg
+  void *volatile arg;
+  std::function<void(void)> callback;  // std::function attached, called through handler
 } gpio_irq_conf_str;
 
 /* Private_Defines */
 #define NB_EXTI   (16)
 
+/* EXTI lines sharing an interrupt */
+#define EXTI_LINES_4_15   (0xFFF0U)
+#define EXTI_LINES_5_9    (0x03E0U)
+#define EXTI_LINES_10_15  (0xFC00U)
+
 /* Private Variables */
 static gpio_irq_conf_str gpio_irq_conf[NB_EXTI] = {
 #if defined (STM32F0xx) || defined (STM32G0xx) || defined (STM32L0xx)
-  {.irqnb = EXTI0_1_IRQn,   .callback = NULL}, //GPIO_PIN_0
-  {.irqnb = EXTI0_1_IRQn,   .callback = NULL}, //GPIO_PIN_1
-  {.irqnb = EXTI2_3_IRQn,   .callback = NULL}, //GPIO_PIN_2
-  {.irqnb = EXTI2_3_IRQn,   .callback = NULL}, //GPIO_PIN_3
-  {.irqnb = EXTI4_15_IRQn,  .callback = NULL}, //GPIO_PIN_4
-  {.irqnb = EXTI4_15_IRQn,  .callback = NULL}, //GPIO_PIN_5
-  {.irqnb = EXTI4_15_IRQn,  .callback = NULL}, //GPIO_PIN_6
-  {.irqnb = EXTI4_15_IRQn,  .callback = NULL}, //GPIO_PIN_7
-  {.irqnb = EXTI4_15_IRQn,  .callback = NULL}, //GPIO_PIN_8
-  {.irqnb = EXTI4_15_IRQn,  .callback = NULL}, //GPIO_PIN_9
-  {.irqnb = EXTI4_15_IRQn,  .callback = NULL}, //GPIO_PIN_10
-  {.irqnb = EXTI4_15_IRQn,  .callback = NULL}, //GPIO_PIN_11
-  {.irqnb = EXTI4_15_IRQn,  .callback = NULL}, //GPIO_PIN_12
-  {.irqnb = EXTI4_15_IRQn,  .callback = NULL}, //GPIO_PIN_13
-  {.irqnb = EXTI4_15_IRQn,  .callback = NULL}, //GPIO_PIN_14
-  {.irqnb = EXTI4_15_IRQn,  .callback = NULL}  //GPIO_PIN_15
+  {.irqnb = EXTI0_1_IRQn,   .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_0
+  {.irqnb = EXTI0_1_IRQn,   .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_1
+  {.irqnb = EXTI2_3_IRQn,   .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_2
+  {.irqnb = EXTI2_3_IRQn,   .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_3
+  {.irqnb = EXTI4_15_IRQn,  .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_4
+  {.irqnb = EXTI4_15_IRQn,  .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_5
+  {.irqnb = EXTI4_15_IRQn,  .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_6
+  {.irqnb = EXTI4_15_IRQn,  .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_7
+  {.irqnb = EXTI4_15_IRQn,  .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_8
+  {.irqnb = EXTI4_15_IRQn,  .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_9
+  {.irqnb = EXTI4_15_IRQn,  .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_10
+  {.irqnb = EXTI4_15_IRQn,  .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_11
+  {.irqnb = EXTI4_15_IRQn,  .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_12
+  {.irqnb = EXTI4_15_IRQn,  .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_13
+  {.irqnb = EXTI4_15_IRQn,  .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_14
+  {.irqnb = EXTI4_15_IRQn,  .handler = NULL, .arg = NULL, .callback = NULL}  //GPIO_PIN_15
 #elif defined (STM32MP1xx)
-  {.irqnb = EXTI0_IRQn,     .callback = NULL}, //GPIO_PIN_0
-  {.irqnb = EXTI1_IRQn,     .callback = NULL}, //GPIO_PIN_1
-  {.irqnb = EXTI2_IRQn,     .callback = NULL}, //GPIO_PIN_2
-  {.irqnb = EXTI3_IRQn,     .callback = NULL}, //GPIO_PIN_3
-  {.irqnb = EXTI4_IRQn,     .callback = NULL}, //GPIO_PIN_4
-  {.irqnb = EXTI5_IRQn,     .callback = NULL}, //GPIO_PIN_5
-  {.irqnb = EXTI6_IRQn,     .callback = NULL}, //GPIO_PIN_6
-  {.irqnb = EXTI7_IRQn,     .callback = NULL}, //GPIO_PIN_7
-  {.irqnb = EXTI8_IRQn,     .callback = NULL}, //GPIO_PIN_8
-  {.irqnb = EXTI9_IRQn,     .callback = NULL}, //GPIO_PIN_9
-  {.irqnb = EXTI10_IRQn,    .callback = NULL}, //GPIO_PIN_10
-  {.irqnb = EXTI11_IRQn,    .callback = NULL}, //GPIO_PIN_11
-  {.irqnb = EXTI12_IRQn,    .callback = NULL}, //GPIO_PIN_12
-  {.irqnb = EXTI13_IRQn,    .callback = NULL}, //GPIO_PIN_13
-  {.irqnb = EXTI14_IRQn,    .callback = NULL}, //GPIO_PIN_14
-  {.irqnb = EXTI15_IRQn,    .callback = NULL}  //GPIO_PIN_15
+  {.irqnb = EXTI0_IRQn,     .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_0
+  {.irqnb = EXTI1_IRQn,     .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_1
+  {.irqnb = EXTI2_IRQn,     .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_2
+  {.irqnb = EXTI3_IRQn,     .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_3
+  {.irqnb = EXTI4_IRQn,     .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_4
+  {.irqnb = EXTI5_IRQn,     .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_5
+  {.irqnb = EXTI6_IRQn,     .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_6
+  {.irqnb = EXTI7_IRQn,     .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_7
+  {.irqnb = EXTI8_IRQn,     .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_8
+  {.irqnb = EXTI9_IRQn,     .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_9
+  {.irqnb = EXTI10_IRQn,    .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_10
+  {.irqnb = EXTI11_IRQn,    .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_11
+  {.irqnb = EXTI12_IRQn,    .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_12
+  {.irqnb = EXTI13_IRQn,    .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_13
+  {.irqnb = EXTI14_IRQn,    .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_14
+  {.irqnb = EXTI15_IRQn,    .handler = NULL, .arg = NULL, .callback = NULL}  //GPIO_PIN_15
 #else
-  {.irqnb = EXTI0_IRQn,     .callback = NULL}, //GPIO_PIN_0
-  {.irqnb = EXTI1_IRQn,     .callback = NULL}, //GPIO_PIN_1
-  {.irqnb = EXTI2_IRQn,     .callback = NULL}, //GPIO_PIN_2
-  {.irqnb = EXTI3_IRQn,     .callback = NULL}, //GPIO_PIN_3
-  {.irqnb = EXTI4_IRQn,     .callback = NULL}, //GPIO_PIN_4
-  {.irqnb = EXTI9_5_IRQn,   .callback = NULL}, //GPIO_PIN_5
-  {.irqnb = EXTI9_5_IRQn,   .callback = NULL}, //GPIO_PIN_6
-  {.irqnb = EXTI9_5_IRQn,   .callback = NULL}, //GPIO_PIN_7
-  {.irqnb = EXTI9_5_IRQn,   .callback = NULL}, //GPIO_PIN_8
-  {.irqnb = EXTI9_5_IRQn,   .callback = NULL}, //GPIO_PIN_9
-  {.irqnb = EXTI15_10_IRQn, .callback = NULL}, //GPIO_PIN_10
-  {.irqnb = EXTI15_10_IRQn, .callback = NULL}, //GPIO_PIN_11
-  {.irqnb = EXTI15_10_IRQn, .callback = NULL}, //GPIO_PIN_12
-  {.irqnb = EXTI15_10_IRQn, .callback = NULL}, //GPIO_PIN_13
-  {.irqnb = EXTI15_10_IRQn, .callback = NULL}, //GPIO_PIN_14
-  {.irqnb = EXTI15_10_IRQn, .callback = NULL}  //GPIO_PIN_15
+  {.irqnb = EXTI0_IRQn,     .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_0
+  {.irqnb = EXTI1_IRQn,     .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_1
+  {.irqnb = EXTI2_IRQn,     .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_2
+  {.irqnb = EXTI3_IRQn,     .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_3
+  {.irqnb = EXTI4_IRQn,     .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_4
+  {.irqnb = EXTI9_5_IRQn,   .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_5
+  {.irqnb = EXTI9_5_IRQn,   .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_6
+  {.irqnb = EXTI9_5_IRQn,   .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_7
+  {.irqnb = EXTI9_5_IRQn,   .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_8
+  {.irqnb = EXTI9_5_IRQn,   .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_9
+  {.irqnb = EXTI15_10_IRQn, .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_10
+  {.irqnb = EXTI15_10_IRQn, .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_11
+  {.irqnb = EXTI15_10_IRQn, .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_12
+  {.irqnb = EXTI15_10_IRQn, .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_13
+  {.irqnb = EXTI15_10_IRQn, .handler = NULL, .arg = NULL, .callback = NULL}, //GPIO_PIN_14
+  {.irqnb = EXTI15_10_IRQn, .handler = NULL, .arg = NULL, .callback = NULL}  //GPIO_PIN_15
 #endif
 };
 
@@ -125,7 +132,32 @@ static uint8_t get_pin_id(uint16_t pin)
 
   return id;
 }
-void stm32_interrupt_enable(GPIO_TypeDef *port, uint16_t pin, callback_function_t callback, uint32_t mode)
+
+/**
+  * @brief  Handlers calling a std::function or a function without parameter
+  * @param  arg : callback
+  * @retval None
+  */
+static void call_function(void *arg)
+{
+  (*(std::function<void(void)> *)arg)();
+}
+
+static void call_void_function(void *arg)
+{
+  ((void (*)(void))arg)();
+}
+
+/**
+  * @brief  Configure the pin and enable its interruption with handler
+  * @param  port : one of the gpio port
+  * @param  pin : one of the gpio pin
+  * @param  handler : function called from interrupt with arg
+  * @param  arg : user parameter given to handler
+  * @param  mode : one of the supported interrupt mode defined in stm32_hal_gpio
+  * @retval None
+  */
+static void interrupt_enable(GPIO_TypeDef *port, uint16_t pin, void (*handler)(void *), void *arg, uint32_t mode)
 {
   GPIO_InitTypeDef GPIO_InitStruct;
   uint8_t id = get_pin_id(pin);
@@ -189,13 +221,39 @@ void stm32_interrupt_enable(GPIO_TypeDef *port, uint16_t pin, callback_function_
   PERIPH_UNLOCK(port);
 #endif
 
-  gpio_irq_conf[id].callback = callback;
+  // Handler is set last, interrupt could already be enabled: barriers keep
+  // the stores (and the std::function assigned by caller) in this order
+  gpio_irq_conf[id].handler = NULL;
+  __DMB();
+  gpio_irq_conf[id].arg = arg;
+  __DMB();
+  gpio_irq_conf[id].handler = handler;
 
   // Enable and set EXTI Interrupt
   HAL_NVIC_SetPriority(gpio_irq_conf[id].irqnb, EXTI_IRQ_PRIO, EXTI_IRQ_SUBPRIO);
   HAL_NVIC_EnableIRQ(gpio_irq_conf[id].irqnb);
 }
 
+/**
+  * @brief  This function enable the interruption on the selected port/pin
+  * @param  port : one of the gpio port
+  * @param  pin : one of the gpio pin
+  * @param  handler : function called from interrupt with arg
+  * @param  arg : user parameter given to handler
+  * @param  mode : one of the supported interrupt mode defined in stm32_hal_gpio
+  * @retval None
+  */
+void stm32_interrupt_enable(GPIO_TypeDef *port, uint16_t pin, void (*handler)(void *), void *arg, uint32_t mode)
+{
+  uint8_t id = get_pin_id(pin);
+
+  // Release std::function of a previous attachment, not called any more
+  gpio_irq_conf[id].handler = NULL;
+  __DMB();
+  gpio_irq_conf[id].callback = NULL;
+  interrupt_enable(port, pin, handler, arg, mode);
+}
+
 /**
   * @brief  This function enable the interruption on the selected port/pin
   * @param  port : one of the gpio port
@@ -204,11 +262,20 @@ void stm32_interrupt_enable(GPIO_TypeDef *port, uint16_t pin, callback_function_
   * @param  mode : one of the supported interrupt mode defined in stm32_hal_gpio
   * @retval None
   */
-void stm32_interrupt_enable(GPIO_TypeDef *port, uint16_t pin, void (*callback)(void), uint32_t mode)
+void stm32_interrupt_enable(GPIO_TypeDef *port, uint16_t pin, callback_function_t callback, uint32_t mode)
 {
-  std::function<void(void)> _c = callback;
-  stm32_interrupt_enable(port, pin, _c, mode);
+  uint8_t id = get_pin_id(pin);
 
+  // std::function can not be updated while called from interrupt
+  gpio_irq_conf[id].handler = NULL;
+  __DMB();
+  gpio_irq_conf[id].callback = callback;
+  interrupt_enable(port, pin, call_function, &gpio_irq_conf[id].callback, mode);
+}
+
+void stm32_interrupt_enable(GPIO_TypeDef *port, uint16_t pin, void (*callback)(void), uint32_t mode)
+{
+  stm32_interrupt_enable(port, pin, call_void_function, (void *)callback, mode);
 }
 
 /**
@@ -221,11 +288,13 @@ void stm32_interrupt_disable(GPIO_TypeDef *port, uint16_t pin)
 {
   UNUSED(port);
   uint8_t id = get_pin_id(pin);
+  gpio_irq_conf[id].handler = NULL;
+  __DMB();
   gpio_irq_conf[id].callback = NULL;
 
   for (int i = 0; i < NB_EXTI; i++) {
     if (gpio_irq_conf[id].irqnb == gpio_irq_conf[i].irqnb
-        && gpio_irq_conf[i].callback != NULL) {
+        && gpio_irq_conf[i].handler != NULL) {
       return;
     }
   }
@@ -240,9 +309,48 @@ void stm32_interrupt_disable(GPIO_TypeDef *port, uint16_t pin)
 void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
 {
   uint8_t irq_id = get_pin_id(GPIO_Pin);
+  void (*handler)(void *) = gpio_irq_conf[irq_id].handler;
 
-  if (gpio_irq_conf[irq_id].callback != NULL) {
-    gpio_irq_conf[irq_id].callback();
+  if (handler != NULL) {
+    handler(gpio_irq_conf[irq_id].arg);
+  }
+}
+
+/**
+  * @brief  Call handlers of pending EXTI lines, pending register is read once
+  * @param  lines : EXTI lines (GPIO_PIN_x) served by the interrupt
+  * @retval None
+  */
+static inline void stm32_interrupt_dispatch(uint32_t lines)
+{
+#if defined (STM32G0xx) || defined (STM32MP1xx)
+  uint32_t rising = __HAL_GPIO_EXTI_GET_RISING_IT(lines);
+  uint32_t falling = __HAL_GPIO_EXTI_GET_FALLING_IT(lines);
+  if (rising) {
+    __HAL_GPIO_EXTI_CLEAR_RISING_IT(rising);
+  }
+  if (falling) {
+    __HAL_GPIO_EXTI_CLEAR_FALLING_IT(falling);
+  }
+  uint32_t pending = rising | falling;
+#elif defined(DUAL_CORE) && defined(CORE_CM4)
+  uint32_t pending = __HAL_GPIO_EXTID2_GET_IT(lines);
+  if (pending) {
+    __HAL_GPIO_EXTID2_CLEAR_IT(pending);
+  }
+#else
+  uint32_t pending = __HAL_GPIO_EXTI_GET_IT(lines);
+  if (pending) {
+    __HAL_GPIO_EXTI_CLEAR_IT(pending);
+  }
+#endif
+  while (pending) {
+    uint32_t id = __builtin_ctz(pending);
+    pending &= pending - 1;
+    void (*handler)(void *) = gpio_irq_conf[id].handler;
+    if (handler != NULL) {
+      handler(gpio_irq_conf[id].arg);
+    }
   }
 }
 
@@ -280,10 +388,7 @@ extern "C" {
   */
 void EXTI0_1_IRQHandler(void)
 {
-  uint32_t pin;
-  for (pin = GPIO_PIN_0; pin <= GPIO_PIN_1; pin = pin << 1) {
-    HAL_GPIO_EXTI_IRQHandler(pin);
-  }
+  stm32_interrupt_dispatch(GPIO_PIN_0 | GPIO_PIN_1);
 }
 
 
@@ -294,10 +399,7 @@ void EXTI0_1_IRQHandler(void)
   */
 void EXTI2_3_IRQHandler(void)
 {
-  uint32_t pin;
-  for (pin = GPIO_PIN_2; pin <= GPIO_PIN_3; pin = pin << 1) {
-    HAL_GPIO_EXTI_IRQHandler(pin);
-  }
+  stm32_interrupt_dispatch(GPIO_PIN_2 | GPIO_PIN_3);
 }
 
 /**
@@ -307,10 +409,7 @@ void EXTI2_3_IRQHandler(void)
   */
 void EXTI4_15_IRQHandler(void)
 {
-  uint32_t pin;
-  for (pin = GPIO_PIN_4; pin <= GPIO_PIN_15; pin = pin << 1) {
-    HAL_GPIO_EXTI_IRQHandler(pin);
-  }
+  stm32_interrupt_dispatch(EXTI_LINES_4_15);
 }
 #ifdef __cplusplus
 }
@@ -326,7 +425,7 @@ extern "C" {
   */
 void EXTI0_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_0);
+  stm32_interrupt_dispatch(GPIO_PIN_0);
 }
 
 /**
@@ -336,7 +435,7 @@ void EXTI0_IRQHandler(void)
   */
 void EXTI1_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_1);
+  stm32_interrupt_dispatch(GPIO_PIN_1);
 }
 
 /**
@@ -346,7 +445,7 @@ void EXTI1_IRQHandler(void)
   */
 void EXTI2_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_2);
+  stm32_interrupt_dispatch(GPIO_PIN_2);
 }
 
 /**
@@ -356,7 +455,7 @@ void EXTI2_IRQHandler(void)
   */
 void EXTI3_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_3);
+  stm32_interrupt_dispatch(GPIO_PIN_3);
 }
 
 /**
@@ -366,7 +465,7 @@ void EXTI3_IRQHandler(void)
   */
 void EXTI4_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_4);
+  stm32_interrupt_dispatch(GPIO_PIN_4);
 }
 
 #if !defined(STM32MP1xx)
@@ -377,10 +476,7 @@ void EXTI4_IRQHandler(void)
   */
 void EXTI9_5_IRQHandler(void)
 {
-  uint32_t pin;
-  for (pin = GPIO_PIN_5; pin <= GPIO_PIN_9; pin = pin << 1) {
-    HAL_GPIO_EXTI_IRQHandler(pin);
-  }
+  stm32_interrupt_dispatch(EXTI_LINES_5_9);
 }
 
 /**
@@ -390,10 +486,7 @@ void EXTI9_5_IRQHandler(void)
   */
 void EXTI15_10_IRQHandler(void)
 {
-  uint32_t pin;
-  for (pin = GPIO_PIN_10; pin <= GPIO_PIN_15; pin = pin << 1) {
-    HAL_GPIO_EXTI_IRQHandler(pin);
-  }
+  stm32_interrupt_dispatch(EXTI_LINES_10_15);
 }
 #else /* STM32MP1xx */
 
@@ -404,7 +497,7 @@ void EXTI15_10_IRQHandler(void)
   */
 void EXTI5_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_5);
+  stm32_interrupt_dispatch(GPIO_PIN_5);
 }
 
 /**
@@ -414,7 +507,7 @@ void EXTI5_IRQHandler(void)
   */
 void EXTI6_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_6);
+  stm32_interrupt_dispatch(GPIO_PIN_6);
 }
 
 /**
@@ -424,7 +517,7 @@ void EXTI6_IRQHandler(void)
   */
 void EXTI7_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_7);
+  stm32_interrupt_dispatch(GPIO_PIN_7);
 }
 
 /**
@@ -434,7 +527,7 @@ void EXTI7_IRQHandler(void)
   */
 void EXTI8_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_8);
+  stm32_interrupt_dispatch(GPIO_PIN_8);
 }
 
 /**
@@ -444,7 +537,7 @@ void EXTI8_IRQHandler(void)
   */
 void EXTI9_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_9);
+  stm32_interrupt_dispatch(GPIO_PIN_9);
 }
 
 /**
@@ -454,7 +547,7 @@ void EXTI9_IRQHandler(void)
   */
 void EXTI10_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_10);
+  stm32_interrupt_dispatch(GPIO_PIN_10);
 }
 
 /**
@@ -464,7 +557,7 @@ void EXTI10_IRQHandler(void)
   */
 void EXTI11_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_11);
+  stm32_interrupt_dispatch(GPIO_PIN_11);
 }
 
 /**
@@ -474,7 +567,7 @@ void EXTI11_IRQHandler(void)
   */
 void EXTI12_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_12);
+  stm32_interrupt_dispatch(GPIO_PIN_12);
 }
 
 /**
@@ -484,7 +577,7 @@ void EXTI12_IRQHandler(void)
   */
 void EXTI13_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_13);
+  stm32_interrupt_dispatch(GPIO_PIN_13);
 }
 
 /**
@@ -494,7 +587,7 @@ void EXTI13_IRQHandler(void)
   */
 void EXTI14_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_14);
+  stm32_interrupt_dispatch(GPIO_PIN_14);
 }
 
 /**
@@ -504,7 +597,7 @@ void EXTI14_IRQHandler(void)
   */
 void EXTI15_IRQHandler(void)
 {
-  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_15);
+  stm32_interrupt_dispatch(GPIO_PIN_15);
 }
 
 #endif /* !STM32MP1xx */
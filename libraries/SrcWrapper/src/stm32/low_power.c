@@ -200,6 +200,23 @@ void LowPower_sleep(uint32_t regulator)
   }
 }
 
+/**
+  * @brief  Enter sleep mode until next interrupt.
+  * @note   Unlike LowPower_sleep(), tick is not suspended: time keeps running
+  *         and the core wakes up at least once per tick. Regulator is left
+  *         as is: HAL_PWR_EnterSLEEPMode() with PWR_MAINREGULATOR_ON would
+  *         exit low-power run mode on some series (ex: L4, G4, WB).
+  * @param  None
+  * @retval None
+  */
+void LowPower_idle(void)
+{
+  /* Sleep mode, not deep sleep */
+  CLEAR_BIT(SCB->SCR, SCB_SCR_SLEEPDEEP_Msk);
+  __DSB();
+  __WFI();
+}
+
 /**
   * @brief  Enable the stop mode.
   * @param  obj : pointer to serial_t structure
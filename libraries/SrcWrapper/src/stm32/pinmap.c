@@ -42,16 +42,43 @@ const uint32_t pin_map_ll[16] = {
   LL_GPIO_PIN_15
 };
 
-bool pin_in_pinmap(PinName pin, const PinMap *map)
+/* Optional: variant PeripheralPins.c may not provide it */
+extern const PinMapIndex PinMap_Index[] __attribute__((weak));
+
+/**
+ * Return first entry of pin in map, NULL if not found
+ */
+static const PinMap *pinmap_find(PinName pin, const PinMap *map)
 {
-  if (pin != (PinName)NC) {
-    while (map->pin != NC) {
-      if (map->pin == pin) {
-        return true;
+  if ((PinMap_Index != NULL) && (STM_PORT(pin) < MAX_NB_PORT)) {
+    for (const PinMapIndex *index = PinMap_Index; index->map != NULL; index++) {
+      if (index->map == map) {
+        /* Entries of a port are consecutive */
+        const PinMap *entry = &map[index->first[STM_PORT(pin)]];
+        const PinMap *end = entry + index->count[STM_PORT(pin)];
+        for (; entry < end; entry++) {
+          if (entry->pin == pin) {
+            return entry;
+          }
+        }
+        return NULL;
       }
-      map++;
     }
   }
+  while (map->pin != NC) {
+    if (map->pin == pin) {
+      return map;
+    }
+    map++;
+  }
+  return NULL;
+}
+
+bool pin_in_pinmap(PinName pin, const PinMap *map)
+{
+  if (pin != (PinName)NC) {
+    return (pinmap_find(pin, map) != NULL);
+  }
   return false;
 }
 
@@ -147,25 +174,18 @@ void pinmap_pinout(PinName pin, const PinMap *map)
     return;
   }
 
-  while (map->pin != NC) {
-    if (map->pin == pin) {
-      pin_function(pin, map->function);
-      return;
-    }
-    map++;
+  map = pinmap_find(pin, map);
+  if (map != NULL) {
+    pin_function(pin, map->function);
+    return;
   }
   Error_Handler();
 }
 
 void *pinmap_find_peripheral(PinName pin, const PinMap *map)
 {
-  while (map->pin != NC) {
-    if (map->pin == pin) {
-      return map->peripheral;
-    }
-    map++;
-  }
-  return NP;
+  map = pinmap_find(pin, map);
+  return (map != NULL) ? map->peripheral : NP;
 }
 
 void *pinmap_peripheral(PinName pin, const PinMap *map)
@@ -201,13 +221,8 @@ PinName pinmap_pin(void *peripheral, const PinMap *map)
 
 uint32_t pinmap_find_function(PinName pin, const PinMap *map)
 {
-  while (map->pin != NC) {
-    if (map->pin == pin) {
-      return map->function;
-    }
-    map++;
-  }
-  return (uint32_t)NC;
+  map = pinmap_find(pin, map);
+  return (map != NULL) ? (uint32_t)map->function : (uint32_t)NC;
 }
 
 uint32_t pinmap_function(PinName pin, const PinMap *map)
@@ -0,0 +1,231 @@
+/*
+  Copyright (c) 2020 STMicroelectronics. All right reserved.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+/*
+ * Tickless time base: when TICKLESS_TIMER is defined (ex: -DTICKLESS_TIMER=TIM2
+ * in build_opt.h), HAL time base is a free running timer counting microseconds
+ * (or the timer clock when slower, or a close rate converted to microseconds
+ * when the timer clock is not a multiple of 1 MHz) instead of the 1 ms SysTick
+ * interrupt. SysTick is not started, the only
+ * interrupt left is the timer overflow: every 71 minutes with a 32-bit timer,
+ * every 65 ms with a 16-bit one. The timer can not be used by the sketch.
+ */
+#include "stm32_def.h"
+#include "clock.h"
+
+#if defined(TICKLESS_TIMER)
+#include "HardwareTimer.h"
+
+#if !defined(HAL_TIM_MODULE_ENABLED) || defined(HAL_TIM_MODULE_ONLY)
+#error "TICKLESS_TIMER requires HAL TIM module"
+#endif
+
+static HardwareTimer *timebase = NULL;
+/* Microseconds counted before last timer reconfiguration */
+static uint64_t timebaseOffset = 0;
+static volatile uint32_t timebaseOverflows = 0;
+/* Counter period in timer ticks */
+static uint64_t timebasePeriod = 0;
+/* Counter clock is timebaseClock / timebaseDivider Hz, exactly 1 MHz in most cases */
+static uint32_t timebaseClock = 1000000;
+static uint32_t timebaseDivider = 1;
+static bool timebaseExact = true;
+/* Last value returned, to stay monotonic */
+static uint64_t timebaseLast = 0;
+/* Cleared when a wake up is set, set by its interrupt */
+static volatile bool timebaseWoken = true;
+
+static void timebaseUpdateCallback(void *arg)
+{
+  UNUSED(arg);
+  timebaseOverflows++;
+}
+
+static void timebaseWakeupCallback(void *arg)
+{
+  UNUSED(arg);
+  timebaseWoken = true;
+}
+
+/**
+  * @brief  Convert counter ticks to microseconds
+  * @param  ticks: counter ticks
+  * @retval Microseconds
+  */
+static inline uint64_t timebaseTicksToMicros(uint64_t ticks)
+{
+  if (timebaseExact) {
+    return ticks;
+  }
+  /* ticks * timebaseDivider / timebaseClock seconds, without overflow */
+  uint64_t scaled = ticks * timebaseDivider;
+  return ((scaled / timebaseClock) * 1000000) + (((scaled % timebaseClock) * 1000000) / timebaseClock);
+}
+
+/**
+  * @brief  Read time base, can be called from any interrupt priority
+  * @retval Microseconds since start
+  */
+uint64_t timebaseGetMicros64(void)
+{
+  if (timebase == NULL) {
+    return 0;
+  }
+  TIM_TypeDef *tim = TICKLESS_TIMER;
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  uint32_t overflows = timebaseOverflows;
+  uint32_t counter = LL_TIM_GetCounter(tim);
+  if (LL_TIM_IsActiveFlag_UPDATE(tim)) {
+    /* Overflow not handled yet, counter may have been read before or after it */
+    overflows++;
+    counter = LL_TIM_GetCounter(tim);
+  }
+  uint64_t now = timebaseOffset + timebaseTicksToMicros((overflows * timebasePeriod) + counter);
+
+  /* Interrupt of higher priority preempting the update callback */
+  if (now < timebaseLast) {
+    now = timebaseLast;
+  }
+  timebaseLast = now;
+
+  __set_PRIMASK(primask);
+  return now;
+}
+
+/**
+  * @brief  Make sure an interrupt occurs in the given time, used to wake up
+  *         from sleep as there is no periodic tick.
+  * @param  us: microseconds from now, limited to the counter period
+  * @retval None
+  */
+void timebaseSetWakeup(uint32_t us)
+{
+  if (timebase == NULL) {
+    return;
+  }
+  TIM_TypeDef *tim = TICKLESS_TIMER;
+  uint32_t mask = (uint32_t)(timebasePeriod - 1);
+
+  if (!timebase->hasInterrupt(1)) {
+    timebase->setMode(1, TIMER_OUTPUT_COMPARE);
+    timebase->attachInterrupt(1, timebaseWakeupCallback, NULL);
+  }
+  uint64_t ticks = us;
+  if (!timebaseExact) {
+    /* Rounded up, wake up must not occur early */
+    uint64_t unit = (uint64_t)timebaseDivider * 1000000;
+    ticks = (((uint64_t)us * timebaseClock) + unit - 1) / unit;
+  }
+  ticks = (ticks == 0) ? 1 : ((ticks > mask) ? mask : ticks);
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  timebaseWoken = false;
+  uint32_t compare = (LL_TIM_GetCounter(tim) + (uint32_t)ticks) & mask;
+  LL_TIM_OC_SetCompareCH1(tim, compare);
+  /* Counter already passed compare value: no match before a full period */
+  if (((compare - LL_TIM_GetCounter(tim)) & mask) > ticks) {
+    LL_TIM_GenerateEvent_CC1(tim);
+  }
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Tell whether the wake up set by timebaseSetWakeup() is still to come
+  * @note   Call it with interrupts disabled right before WFI: if the wake up
+  *         interrupt already occurred, WFI would not return before the next one.
+  * @retval true if wake up interrupt did not occur yet
+  */
+bool timebaseWakeupPending(void)
+{
+  return !timebaseWoken;
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+  * @brief  Configure time base, called by HAL_Init() and after each system clock change
+  * @param  TickPriority: time base interrupt priority
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
+{
+  TIM_TypeDef *tim = TICKLESS_TIMER;
+
+  if (TickPriority >= (1UL << __NVIC_PRIO_BITS)) {
+    return HAL_ERROR;
+  }
+
+  if (timebase == NULL) {
+    timebase = new HardwareTimer(tim);
+    timebase->attachInterrupt(timebaseUpdateCallback, NULL);
+#if defined(IS_TIM_32B_COUNTER_INSTANCE)
+    timebasePeriod = IS_TIM_32B_COUNTER_INSTANCE(tim) ? 0x100000000ULL : 0x10000ULL;
+#else
+    timebasePeriod = 0x10000ULL;
+#endif
+    LL_TIM_SetAutoReload(tim, (uint32_t)(timebasePeriod - 1));
+    /* Update generation below must not be counted as an overflow */
+    LL_TIM_SetUpdateSource(tim, LL_TIM_UPDATESOURCE_COUNTER);
+    LL_TIM_ClearFlag_UPDATE(tim);
+  }
+  timebase->setInterruptPriority(TickPriority, 0);
+#if !defined(STM32L0xx)
+  uwTickPrio = TickPriority;
+#endif
+
+  /* Keep time elapsed so far and restart counting at 1 MHz from the new clock.
+     Timer clock below 1 MHz is not divided, timer clock which is not a multiple
+     of 1 MHz gives a close rate, counter is then converted to microseconds */
+  uint32_t clock = timebase->getTimerClkFreq();
+  uint32_t divider = (clock >= 1000000) ? (clock / 1000000) : 1;
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  timebaseOffset = timebaseGetMicros64();
+  timebaseOverflows = 0;
+  timebaseClock = clock;
+  timebaseDivider = divider;
+  timebaseExact = (clock == divider * 1000000);
+  LL_TIM_SetPrescaler(tim, divider - 1);
+  LL_TIM_GenerateEvent_UPDATE(tim);
+  LL_TIM_ClearFlag_UPDATE(tim);
+  __set_PRIMASK(primask);
+
+  timebase->resume();
+  return HAL_OK;
+}
+
+/**
+  * @brief  Provide a tick value in millisecond, used by HAL timeouts
+  * @retval tick value
+  */
+uint32_t HAL_GetTick(void)
+{
+  return (uint32_t)(timebaseGetMicros64() / 1000);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TICKLESS_TIMER */
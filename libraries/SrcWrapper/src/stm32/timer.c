@@ -716,6 +716,939 @@ uint8_t getTimerClkSrc(TIM_TypeDef *tim)
 }
 
 
+/**
+  * @brief  Enable clock of DMA controllers used by timers
+  * @param  None
+  * @retval None
+  */
+static void enableTimerDmaClock(void)
+{
+  __HAL_RCC_DMA1_CLK_ENABLE();
+#if defined(DMA2)
+  __HAL_RCC_DMA2_CLK_ENABLE();
+#endif
+#ifdef __HAL_RCC_DMAMUX1_CLK_ENABLE
+  __HAL_RCC_DMAMUX1_CLK_ENABLE();
+#endif
+}
+
+/* DMA streams/channels in use by timers and by ADC/DAC streams */
+#ifndef DMA_OWNER_NB
+#define DMA_OWNER_NB  (TIMER_NUM + 2)
+#endif
+
+typedef struct {
+  uint32_t instance;
+  DMA_HandleTypeDef *hdma;
+} dma_owner_t;
+
+static dma_owner_t dmaOwner[DMA_OWNER_NB] = {};
+
+#if defined(DMAMUX1)
+/* Any stream/channel can serve a timer request through the DMAMUX, last
+   ones are tried first as ADC and DAC streams use the first ones of DMA1 */
+static const uint32_t dmaCandidates[] = {
+#if defined(DMA1_Stream0)
+#if defined(DMA2_Stream7)
+  DMA2_Stream7_BASE,
+#endif
+#if defined(DMA2_Stream6)
+  DMA2_Stream6_BASE,
+#endif
+#if defined(DMA2_Stream5)
+  DMA2_Stream5_BASE,
+#endif
+#if defined(DMA2_Stream4)
+  DMA2_Stream4_BASE,
+#endif
+#if defined(DMA2_Stream3)
+  DMA2_Stream3_BASE,
+#endif
+#if defined(DMA2_Stream2)
+  DMA2_Stream2_BASE,
+#endif
+#if defined(DMA2_Stream1)
+  DMA2_Stream1_BASE,
+#endif
+#if defined(DMA2_Stream0)
+  DMA2_Stream0_BASE,
+#endif
+#if defined(DMA1_Stream7)
+  DMA1_Stream7_BASE,
+#endif
+#if defined(DMA1_Stream6)
+  DMA1_Stream6_BASE,
+#endif
+#if defined(DMA1_Stream5)
+  DMA1_Stream5_BASE,
+#endif
+#if defined(DMA1_Stream4)
+  DMA1_Stream4_BASE,
+#endif
+#if defined(DMA1_Stream3)
+  DMA1_Stream3_BASE,
+#endif
+#if defined(DMA1_Stream2)
+  DMA1_Stream2_BASE,
+#endif
+#if defined(DMA1_Stream1)
+  DMA1_Stream1_BASE,
+#endif
+#if defined(DMA1_Stream0)
+  DMA1_Stream0_BASE,
+#endif
+#else
+#if defined(DMA2_Channel8)
+  DMA2_Channel8_BASE,
+#endif
+#if defined(DMA2_Channel7)
+  DMA2_Channel7_BASE,
+#endif
+#if defined(DMA2_Channel6)
+  DMA2_Channel6_BASE,
+#endif
+#if defined(DMA2_Channel5)
+  DMA2_Channel5_BASE,
+#endif
+#if defined(DMA2_Channel4)
+  DMA2_Channel4_BASE,
+#endif
+#if defined(DMA2_Channel3)
+  DMA2_Channel3_BASE,
+#endif
+#if defined(DMA2_Channel2)
+  DMA2_Channel2_BASE,
+#endif
+#if defined(DMA2_Channel1)
+  DMA2_Channel1_BASE,
+#endif
+#if defined(DMA1_Channel8)
+  DMA1_Channel8_BASE,
+#endif
+#if defined(DMA1_Channel7)
+  DMA1_Channel7_BASE,
+#endif
+#if defined(DMA1_Channel6)
+  DMA1_Channel6_BASE,
+#endif
+#if defined(DMA1_Channel5)
+  DMA1_Channel5_BASE,
+#endif
+#if defined(DMA1_Channel4)
+  DMA1_Channel4_BASE,
+#endif
+#if defined(DMA1_Channel3)
+  DMA1_Channel3_BASE,
+#endif
+#if defined(DMA1_Channel2)
+  DMA1_Channel2_BASE,
+#endif
+#if defined(DMA1_Channel1)
+  DMA1_Channel1_BASE,
+#endif
+#endif
+};
+#endif /* DMAMUX1 */
+
+/**
+  * @brief  Check whether a DMA stream/channel is used by another handle
+  * @param  instance: DMA stream/channel base address
+  * @param  hdma: DMA handle which wants to use it, NULL if none
+  * @retval true if the stream/channel is in use
+  */
+static bool isDmaBusy(uint32_t instance, DMA_HandleTypeDef *hdma)
+{
+  for (uint32_t i = 0; i < DMA_OWNER_NB; i++) {
+    if ((dmaOwner[i].instance == instance) && (dmaOwner[i].hdma != hdma)) {
+      return true;
+    }
+  }
+  /* Enabled by code which does not use acquireDma() */
+#if defined(DMA_SxCR_EN)
+  return (((DMA_Stream_TypeDef *)instance)->CR & DMA_SxCR_EN) != 0;
+#else
+  return (((DMA_Channel_TypeDef *)instance)->CCR & DMA_CCR_EN) != 0;
+#endif
+}
+
+#if defined(DMAMUX1)
+/**
+  * @brief  Find a DMA stream/channel which is not in use
+  * @param  None
+  * @retval stream/channel base address, 0 if all are in use
+  */
+static uint32_t getFreeDma(void)
+{
+  enableTimerDmaClock();
+  for (uint32_t i = 0; i < sizeof(dmaCandidates) / sizeof(dmaCandidates[0]); i++) {
+    if (!isDmaBusy(dmaCandidates[i], NULL)) {
+      return dmaCandidates[i];
+    }
+  }
+  return 0;
+}
+#endif /* DMAMUX1 */
+
+/**
+  * @brief  Reserve the DMA stream/channel of a handle before HAL_DMA_Init()
+  * @param  hdma: DMA handle, its Instance must be set
+  * @retval true if the stream/channel is reserved for hdma, false if it is
+  *         already in use
+  */
+bool acquireDma(DMA_HandleTypeDef *hdma)
+{
+  uint32_t instance = (uint32_t)hdma->Instance;
+  dma_owner_t *entry = NULL;
+
+  if (instance == 0) {
+    return false;
+  }
+  enableTimerDmaClock();
+  if (isDmaBusy(instance, hdma)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < DMA_OWNER_NB; i++) {
+    if (dmaOwner[i].hdma == hdma) {
+      /* Handle moved to another stream/channel */
+      entry = &dmaOwner[i];
+      break;
+    }
+    if ((entry == NULL) && (dmaOwner[i].hdma == NULL)) {
+      entry = &dmaOwner[i];
+    }
+  }
+  if (entry == NULL) {
+    return false;
+  }
+  entry->instance = instance;
+  entry->hdma = hdma;
+  return true;
+}
+
+/**
+  * @brief  Release the DMA stream/channel reserved by acquireDma()
+  * @param  hdma: DMA handle
+  * @retval None
+  */
+void releaseDma(DMA_HandleTypeDef *hdma)
+{
+  for (uint32_t i = 0; i < DMA_OWNER_NB; i++) {
+    if (dmaOwner[i].hdma == hdma) {
+      dmaOwner[i].instance = 0;
+      dmaOwner[i].hdma = NULL;
+    }
+  }
+}
+
+/**
+  * @brief  This function fill the DMA handle with the stream/channel (and the
+  *         request) serving the update event of timer instance, and enable
+  *         the DMA clock.
+  * @note   DMA interrupt is not used. Only the default mapping of the
+  *         reference manual is handled; on devices with a DMAMUX, a stream/
+  *         channel not in use is picked. Reserve it with acquireDma().
+  * @param  tim: timer instance
+  * @param  hdma: DMA handle to fill
+  * @retval true if a DMA is available for this timer, false otherwise
+  */
+bool getTimerUpDma(TIM_TypeDef *tim, DMA_HandleTypeDef *hdma)
+{
+  bool found = true;
+
+  if ((tim == (TIM_TypeDef *)NC) || (hdma == NULL)) {
+    return false;
+  }
+#if defined(DMAMUX1)
+  switch ((uint32_t)tim) {
+#if defined(TIM1_BASE) && defined(DMA_REQUEST_TIM1_UP)
+    case (uint32_t)TIM1_BASE:
+      hdma->Init.Request = DMA_REQUEST_TIM1_UP;
+      break;
+#endif
+#if defined(TIM2_BASE) && defined(DMA_REQUEST_TIM2_UP)
+    case (uint32_t)TIM2_BASE:
+      hdma->Init.Request = DMA_REQUEST_TIM2_UP;
+      break;
+#endif
+#if defined(TIM3_BASE) && defined(DMA_REQUEST_TIM3_UP)
+    case (uint32_t)TIM3_BASE:
+      hdma->Init.Request = DMA_REQUEST_TIM3_UP;
+      break;
+#endif
+#if defined(TIM4_BASE) && defined(DMA_REQUEST_TIM4_UP)
+    case (uint32_t)TIM4_BASE:
+      hdma->Init.Request = DMA_REQUEST_TIM4_UP;
+      break;
+#endif
+#if defined(TIM5_BASE) && defined(DMA_REQUEST_TIM5_UP)
+    case (uint32_t)TIM5_BASE:
+      hdma->Init.Request = DMA_REQUEST_TIM5_UP;
+      break;
+#endif
+#if defined(TIM8_BASE) && defined(DMA_REQUEST_TIM8_UP)
+    case (uint32_t)TIM8_BASE:
+      hdma->Init.Request = DMA_REQUEST_TIM8_UP;
+      break;
+#endif
+#if defined(TIM15_BASE) && defined(DMA_REQUEST_TIM15_UP)
+    case (uint32_t)TIM15_BASE:
+      hdma->Init.Request = DMA_REQUEST_TIM15_UP;
+      break;
+#endif
+#if defined(TIM16_BASE) && defined(DMA_REQUEST_TIM16_UP)
+    case (uint32_t)TIM16_BASE:
+      hdma->Init.Request = DMA_REQUEST_TIM16_UP;
+      break;
+#endif
+#if defined(TIM17_BASE) && defined(DMA_REQUEST_TIM17_UP)
+    case (uint32_t)TIM17_BASE:
+      hdma->Init.Request = DMA_REQUEST_TIM17_UP;
+      break;
+#endif
+#if defined(TIM20_BASE) && defined(DMA_REQUEST_TIM20_UP)
+    case (uint32_t)TIM20_BASE:
+      hdma->Init.Request = DMA_REQUEST_TIM20_UP;
+      break;
+#endif
+    default:
+      found = false;
+      break;
+  }
+  if (found) {
+    uint32_t instance = getFreeDma();
+#if defined(DMA1_Stream0)
+    hdma->Instance = (DMA_Stream_TypeDef *)instance;
+#else
+    hdma->Instance = (DMA_Channel_TypeDef *)instance;
+#endif
+    found = (instance != 0);
+  }
+#elif defined(DMA1_Stream0)
+  switch ((uint32_t)tim) {
+#if defined(TIM1_BASE)
+    case (uint32_t)TIM1_BASE:
+      hdma->Instance = DMA2_Stream5;
+      hdma->Init.Channel = DMA_CHANNEL_6;
+      break;
+#endif
+#if defined(TIM2_BASE)
+    case (uint32_t)TIM2_BASE:
+      hdma->Instance = DMA1_Stream1;
+      hdma->Init.Channel = DMA_CHANNEL_3;
+      break;
+#endif
+#if defined(TIM3_BASE)
+    case (uint32_t)TIM3_BASE:
+      hdma->Instance = DMA1_Stream2;
+      hdma->Init.Channel = DMA_CHANNEL_5;
+      break;
+#endif
+#if defined(TIM4_BASE)
+    case (uint32_t)TIM4_BASE:
+      hdma->Instance = DMA1_Stream6;
+      hdma->Init.Channel = DMA_CHANNEL_2;
+      break;
+#endif
+#if defined(TIM5_BASE)
+    case (uint32_t)TIM5_BASE:
+      hdma->Instance = DMA1_Stream0;
+      hdma->Init.Channel = DMA_CHANNEL_6;
+      break;
+#endif
+#if defined(TIM8_BASE)
+    case (uint32_t)TIM8_BASE:
+      hdma->Instance = DMA2_Stream1;
+      hdma->Init.Channel = DMA_CHANNEL_7;
+      break;
+#endif
+    default:
+      found = false;
+      break;
+  }
+#else
+  switch ((uint32_t)tim) {
+#if defined(TIM1_BASE)
+    case (uint32_t)TIM1_BASE:
+#if defined(STM32L4xx)
+      hdma->Instance = DMA1_Channel6;
+      hdma->Init.Request = DMA_REQUEST_7;
+#else
+      hdma->Instance = DMA1_Channel5;
+#endif
+      break;
+#endif
+#if defined(TIM2_BASE)
+    case (uint32_t)TIM2_BASE:
+      hdma->Instance = DMA1_Channel2;
+#if defined(STM32L4xx)
+      hdma->Init.Request = DMA_REQUEST_4;
+#elif defined(STM32L0xx)
+      hdma->Init.Request = DMA_REQUEST_8;
+#endif
+      break;
+#endif
+#if defined(TIM3_BASE)
+    case (uint32_t)TIM3_BASE:
+      hdma->Instance = DMA1_Channel3;
+#if defined(STM32L4xx)
+      hdma->Init.Request = DMA_REQUEST_5;
+#elif defined(STM32L0xx)
+      hdma->Init.Request = DMA_REQUEST_10;
+#endif
+      break;
+#endif
+#if defined(TIM4_BASE)
+    case (uint32_t)TIM4_BASE:
+      hdma->Instance = DMA1_Channel7;
+#if defined(STM32L4xx)
+      hdma->Init.Request = DMA_REQUEST_6;
+#endif
+      break;
+#endif
+#if defined(TIM8_BASE) && defined(DMA2_Channel1)
+    case (uint32_t)TIM8_BASE:
+      hdma->Instance = DMA2_Channel1;
+#if defined(STM32L4xx)
+      hdma->Init.Request = DMA_REQUEST_7;
+#endif
+      break;
+#endif
+#if defined(TIM15_BASE)
+    case (uint32_t)TIM15_BASE:
+      hdma->Instance = DMA1_Channel5;
+#if defined(STM32L4xx)
+      hdma->Init.Request = DMA_REQUEST_7;
+#endif
+      break;
+#endif
+#if defined(TIM16_BASE)
+    case (uint32_t)TIM16_BASE:
+      hdma->Instance = DMA1_Channel3;
+#if defined(STM32L4xx)
+      hdma->Init.Request = DMA_REQUEST_4;
+#elif defined(HAL_DMA1_CH3_TIM16_UP)
+      __HAL_DMA1_REMAP(HAL_DMA1_CH3_TIM16_UP);
+#endif
+      break;
+#endif
+#if defined(TIM17_BASE)
+    case (uint32_t)TIM17_BASE:
+#if defined(STM32L4xx)
+      hdma->Instance = DMA1_Channel7;
+      hdma->Init.Request = DMA_REQUEST_5;
+#else
+      hdma->Instance = DMA1_Channel1;
+#if defined(HAL_DMA1_CH1_TIM17_UP)
+      __HAL_DMA1_REMAP(HAL_DMA1_CH1_TIM17_UP);
+#endif
+#endif
+      break;
+#endif
+    default:
+      found = false;
+      break;
+  }
+#endif /* DMAMUX1 */
+
+  if (found) {
+    enableTimerDmaClock();
+  }
+  return found;
+}
+
+#if !defined(DMAMUX1)
+/* Default DMA stream/channel serving capture/compare channels 1 to 4 of a
+   timer, base address is 0 when the channel has no DMA request */
+typedef struct {
+  uint32_t instance;
+  uint32_t request;
+} timer_dma_map_t;
+
+#if defined(DMA1_Stream0)
+#if defined(TIM1_BASE)
+static const timer_dma_map_t TIM1_CC_DMA[4] = {
+  {DMA2_Stream1_BASE, DMA_CHANNEL_6},
+  {DMA2_Stream2_BASE, DMA_CHANNEL_6},
+  {DMA2_Stream6_BASE, DMA_CHANNEL_6},
+  {DMA2_Stream4_BASE, DMA_CHANNEL_6}
+};
+#define TIM1_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM2_BASE)
+static const timer_dma_map_t TIM2_CC_DMA[4] = {
+  {DMA1_Stream5_BASE, DMA_CHANNEL_3},
+  {DMA1_Stream6_BASE, DMA_CHANNEL_3},
+  {DMA1_Stream1_BASE, DMA_CHANNEL_3},
+  {DMA1_Stream7_BASE, DMA_CHANNEL_3}
+};
+#define TIM2_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM3_BASE)
+static const timer_dma_map_t TIM3_CC_DMA[4] = {
+  {DMA1_Stream4_BASE, DMA_CHANNEL_5},
+  {DMA1_Stream5_BASE, DMA_CHANNEL_5},
+  {DMA1_Stream7_BASE, DMA_CHANNEL_5},
+  {DMA1_Stream2_BASE, DMA_CHANNEL_5}
+};
+#define TIM3_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM4_BASE)
+static const timer_dma_map_t TIM4_CC_DMA[4] = {
+  {DMA1_Stream0_BASE, DMA_CHANNEL_2},
+  {DMA1_Stream3_BASE, DMA_CHANNEL_2},
+  {DMA1_Stream7_BASE, DMA_CHANNEL_2},
+  {0, 0}
+};
+#define TIM4_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM5_BASE)
+static const timer_dma_map_t TIM5_CC_DMA[4] = {
+  {DMA1_Stream2_BASE, DMA_CHANNEL_6},
+  {DMA1_Stream4_BASE, DMA_CHANNEL_6},
+  {DMA1_Stream0_BASE, DMA_CHANNEL_6},
+  {DMA1_Stream1_BASE, DMA_CHANNEL_6}
+};
+#define TIM5_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM8_BASE)
+static const timer_dma_map_t TIM8_CC_DMA[4] = {
+  {DMA2_Stream2_BASE, DMA_CHANNEL_7},
+  {DMA2_Stream3_BASE, DMA_CHANNEL_7},
+  {DMA2_Stream4_BASE, DMA_CHANNEL_7},
+  {DMA2_Stream7_BASE, DMA_CHANNEL_7}
+};
+#define TIM8_CC_DMA_AVAILABLE
+#endif
+#elif defined(STM32L4xx)
+#if defined(TIM1_BASE)
+static const timer_dma_map_t TIM1_CC_DMA[4] = {
+  {DMA1_Channel2_BASE, DMA_REQUEST_7},
+  {DMA1_Channel3_BASE, DMA_REQUEST_7},
+  {DMA1_Channel7_BASE, DMA_REQUEST_7},
+  {DMA1_Channel4_BASE, DMA_REQUEST_7}
+};
+#define TIM1_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM2_BASE)
+static const timer_dma_map_t TIM2_CC_DMA[4] = {
+  {DMA1_Channel5_BASE, DMA_REQUEST_4},
+  {DMA1_Channel7_BASE, DMA_REQUEST_4},
+  {DMA1_Channel1_BASE, DMA_REQUEST_4},
+  {DMA1_Channel7_BASE, DMA_REQUEST_4}
+};
+#define TIM2_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM3_BASE)
+static const timer_dma_map_t TIM3_CC_DMA[4] = {
+  {DMA1_Channel6_BASE, DMA_REQUEST_5},
+  {0, 0},
+  {DMA1_Channel2_BASE, DMA_REQUEST_5},
+  {DMA1_Channel3_BASE, DMA_REQUEST_5}
+};
+#define TIM3_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM4_BASE)
+static const timer_dma_map_t TIM4_CC_DMA[4] = {
+  {DMA1_Channel1_BASE, DMA_REQUEST_6},
+  {DMA1_Channel4_BASE, DMA_REQUEST_6},
+  {DMA1_Channel5_BASE, DMA_REQUEST_6},
+  {0, 0}
+};
+#define TIM4_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM15_BASE)
+static const timer_dma_map_t TIM15_CC_DMA[4] = {
+  {DMA1_Channel5_BASE, DMA_REQUEST_7},
+  {0, 0},
+  {0, 0},
+  {0, 0}
+};
+#define TIM15_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM16_BASE)
+static const timer_dma_map_t TIM16_CC_DMA[4] = {
+  {DMA1_Channel3_BASE, DMA_REQUEST_4},
+  {0, 0},
+  {0, 0},
+  {0, 0}
+};
+#define TIM16_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM17_BASE)
+static const timer_dma_map_t TIM17_CC_DMA[4] = {
+  {DMA1_Channel7_BASE, DMA_REQUEST_5},
+  {0, 0},
+  {0, 0},
+  {0, 0}
+};
+#define TIM17_CC_DMA_AVAILABLE
+#endif
+#elif defined(STM32L0xx)
+#if defined(TIM2_BASE)
+static const timer_dma_map_t TIM2_CC_DMA[4] = {
+  {DMA1_Channel5_BASE, DMA_REQUEST_8},
+  {DMA1_Channel3_BASE, DMA_REQUEST_8},
+  {DMA1_Channel1_BASE, DMA_REQUEST_8},
+  {DMA1_Channel4_BASE, DMA_REQUEST_8}
+};
+#define TIM2_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM3_BASE)
+static const timer_dma_map_t TIM3_CC_DMA[4] = {
+  {0, 0},
+  {0, 0},
+  {DMA1_Channel2_BASE, DMA_REQUEST_10},
+  {DMA1_Channel3_BASE, DMA_REQUEST_10}
+};
+#define TIM3_CC_DMA_AVAILABLE
+#endif
+#elif defined(STM32F0xx)
+#if defined(TIM1_BASE)
+static const timer_dma_map_t TIM1_CC_DMA[4] = {
+  {DMA1_Channel2_BASE, 0},
+  {DMA1_Channel3_BASE, 0},
+  {DMA1_Channel5_BASE, 0},
+  {DMA1_Channel4_BASE, 0}
+};
+#define TIM1_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM2_BASE)
+static const timer_dma_map_t TIM2_CC_DMA[4] = {
+  {DMA1_Channel5_BASE, 0},
+  {DMA1_Channel3_BASE, 0},
+  {DMA1_Channel1_BASE, 0},
+  {DMA1_Channel4_BASE, 0}
+};
+#define TIM2_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM3_BASE)
+static const timer_dma_map_t TIM3_CC_DMA[4] = {
+  {DMA1_Channel4_BASE, 0},
+  {0, 0},
+  {DMA1_Channel2_BASE, 0},
+  {DMA1_Channel3_BASE, 0}
+};
+#define TIM3_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM15_BASE)
+static const timer_dma_map_t TIM15_CC_DMA[4] = {
+  {DMA1_Channel5_BASE, 0},
+  {0, 0},
+  {0, 0},
+  {0, 0}
+};
+#define TIM15_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM16_BASE)
+static const timer_dma_map_t TIM16_CC_DMA[4] = {
+  {DMA1_Channel3_BASE, 0},
+  {0, 0},
+  {0, 0},
+  {0, 0}
+};
+#define TIM16_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM17_BASE)
+static const timer_dma_map_t TIM17_CC_DMA[4] = {
+  {DMA1_Channel1_BASE, 0},
+  {0, 0},
+  {0, 0},
+  {0, 0}
+};
+#define TIM17_CC_DMA_AVAILABLE
+#endif
+#else
+#if defined(TIM1_BASE)
+static const timer_dma_map_t TIM1_CC_DMA[4] = {
+  {DMA1_Channel2_BASE, 0},
+  {DMA1_Channel3_BASE, 0},
+  {DMA1_Channel6_BASE, 0},
+  {DMA1_Channel4_BASE, 0}
+};
+#define TIM1_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM2_BASE)
+static const timer_dma_map_t TIM2_CC_DMA[4] = {
+  {DMA1_Channel5_BASE, 0},
+  {DMA1_Channel7_BASE, 0},
+  {DMA1_Channel1_BASE, 0},
+  {DMA1_Channel7_BASE, 0}
+};
+#define TIM2_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM3_BASE)
+static const timer_dma_map_t TIM3_CC_DMA[4] = {
+  {DMA1_Channel6_BASE, 0},
+  {0, 0},
+  {DMA1_Channel2_BASE, 0},
+  {DMA1_Channel3_BASE, 0}
+};
+#define TIM3_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM4_BASE)
+static const timer_dma_map_t TIM4_CC_DMA[4] = {
+  {DMA1_Channel1_BASE, 0},
+  {DMA1_Channel4_BASE, 0},
+  {DMA1_Channel5_BASE, 0},
+  {0, 0}
+};
+#define TIM4_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM15_BASE)
+static const timer_dma_map_t TIM15_CC_DMA[4] = {
+  {DMA1_Channel5_BASE, 0},
+  {0, 0},
+  {0, 0},
+  {0, 0}
+};
+#define TIM15_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM16_BASE)
+static const timer_dma_map_t TIM16_CC_DMA[4] = {
+  {DMA1_Channel3_BASE, 0},
+  {0, 0},
+  {0, 0},
+  {0, 0}
+};
+#define TIM16_CC_DMA_AVAILABLE
+#endif
+#if defined(TIM17_BASE)
+static const timer_dma_map_t TIM17_CC_DMA[4] = {
+  {DMA1_Channel1_BASE, 0},
+  {0, 0},
+  {0, 0},
+  {0, 0}
+};
+#define TIM17_CC_DMA_AVAILABLE
+#endif
+#endif
+#endif /* !DMAMUX1 */
+
+/**
+  * @brief  This function fill the DMA handle with the stream/channel (and the
+  *         request) serving a capture/compare channel of timer instance, and
+  *         enable the DMA clock.
+  * @note   DMA interrupt is not used. Only the default mapping of the
+  *         reference manual is handled; on devices with a DMAMUX, a stream/
+  *         channel not in use is picked. Reserve it with acquireDma().
+  * @param  tim: timer instance
+  * @param  channel: timer channel [1..4]
+  * @param  hdma: DMA handle to fill
+  * @retval true if a DMA is available for this channel, false otherwise
+  */
+bool getTimerCCDma(TIM_TypeDef *tim, uint32_t channel, DMA_HandleTypeDef *hdma)
+{
+  if ((tim == (TIM_TypeDef *)NC) || (hdma == NULL) || (channel < 1) || (channel > 4)) {
+    return false;
+  }
+#if defined(DMAMUX1)
+  /* CH1 to CH4 requests of a timer are contiguous */
+  uint32_t request = 0;
+  uint32_t nb_channel = 0;
+
+  switch ((uint32_t)tim) {
+#if defined(TIM1_BASE) && defined(DMA_REQUEST_TIM1_CH1)
+    case (uint32_t)TIM1_BASE:
+      request = DMA_REQUEST_TIM1_CH1;
+#if defined(DMA_REQUEST_TIM1_CH4)
+      nb_channel = 4;
+#elif defined(DMA_REQUEST_TIM1_CH3)
+      nb_channel = 3;
+#elif defined(DMA_REQUEST_TIM1_CH2)
+      nb_channel = 2;
+#else
+      nb_channel = 1;
+#endif
+      break;
+#endif
+#if defined(TIM2_BASE) && defined(DMA_REQUEST_TIM2_CH1)
+    case (uint32_t)TIM2_BASE:
+      request = DMA_REQUEST_TIM2_CH1;
+#if defined(DMA_REQUEST_TIM2_CH4)
+      nb_channel = 4;
+#elif defined(DMA_REQUEST_TIM2_CH3)
+      nb_channel = 3;
+#elif defined(DMA_REQUEST_TIM2_CH2)
+      nb_channel = 2;
+#else
+      nb_channel = 1;
+#endif
+      break;
+#endif
+#if defined(TIM3_BASE) && defined(DMA_REQUEST_TIM3_CH1)
+    case (uint32_t)TIM3_BASE:
+      request = DMA_REQUEST_TIM3_CH1;
+#if defined(DMA_REQUEST_TIM3_CH4)
+      nb_channel = 4;
+#elif defined(DMA_REQUEST_TIM3_CH3)
+      nb_channel = 3;
+#elif defined(DMA_REQUEST_TIM3_CH2)
+      nb_channel = 2;
+#else
+      nb_channel = 1;
+#endif
+      break;
+#endif
+#if defined(TIM4_BASE) && defined(DMA_REQUEST_TIM4_CH1)
+    case (uint32_t)TIM4_BASE:
+      request = DMA_REQUEST_TIM4_CH1;
+#if defined(DMA_REQUEST_TIM4_CH4)
+      nb_channel = 4;
+#elif defined(DMA_REQUEST_TIM4_CH3)
+      nb_channel = 3;
+#elif defined(DMA_REQUEST_TIM4_CH2)
+      nb_channel = 2;
+#else
+      nb_channel = 1;
+#endif
+      break;
+#endif
+#if defined(TIM5_BASE) && defined(DMA_REQUEST_TIM5_CH1)
+    case (uint32_t)TIM5_BASE:
+      request = DMA_REQUEST_TIM5_CH1;
+#if defined(DMA_REQUEST_TIM5_CH4)
+      nb_channel = 4;
+#elif defined(DMA_REQUEST_TIM5_CH3)
+      nb_channel = 3;
+#elif defined(DMA_REQUEST_TIM5_CH2)
+      nb_channel = 2;
+#else
+      nb_channel = 1;
+#endif
+      break;
+#endif
+#if defined(TIM8_BASE) && defined(DMA_REQUEST_TIM8_CH1)
+    case (uint32_t)TIM8_BASE:
+      request = DMA_REQUEST_TIM8_CH1;
+#if defined(DMA_REQUEST_TIM8_CH4)
+      nb_channel = 4;
+#elif defined(DMA_REQUEST_TIM8_CH3)
+      nb_channel = 3;
+#elif defined(DMA_REQUEST_TIM8_CH2)
+      nb_channel = 2;
+#else
+      nb_channel = 1;
+#endif
+      break;
+#endif
+#if defined(TIM20_BASE) && defined(DMA_REQUEST_TIM20_CH1)
+    case (uint32_t)TIM20_BASE:
+      request = DMA_REQUEST_TIM20_CH1;
+#if defined(DMA_REQUEST_TIM20_CH4)
+      nb_channel = 4;
+#elif defined(DMA_REQUEST_TIM20_CH3)
+      nb_channel = 3;
+#elif defined(DMA_REQUEST_TIM20_CH2)
+      nb_channel = 2;
+#else
+      nb_channel = 1;
+#endif
+      break;
+#endif
+#if defined(TIM15_BASE) && defined(DMA_REQUEST_TIM15_CH1)
+    case (uint32_t)TIM15_BASE:
+      request = DMA_REQUEST_TIM15_CH1;
+      nb_channel = 1;
+      break;
+#endif
+#if defined(TIM16_BASE) && defined(DMA_REQUEST_TIM16_CH1)
+    case (uint32_t)TIM16_BASE:
+      request = DMA_REQUEST_TIM16_CH1;
+      nb_channel = 1;
+      break;
+#endif
+#if defined(TIM17_BASE) && defined(DMA_REQUEST_TIM17_CH1)
+    case (uint32_t)TIM17_BASE:
+      request = DMA_REQUEST_TIM17_CH1;
+      nb_channel = 1;
+      break;
+#endif
+    default:
+      break;
+  }
+  if (channel > nb_channel) {
+    return false;
+  }
+  uint32_t instance = getFreeDma();
+  if (instance == 0) {
+    return false;
+  }
+  hdma->Init.Request = request + channel - 1;
+#if defined(DMA1_Stream0)
+  hdma->Instance = (DMA_Stream_TypeDef *)instance;
+#else
+  hdma->Instance = (DMA_Channel_TypeDef *)instance;
+#endif
+#else
+  const timer_dma_map_t *map = NULL;
+
+  switch ((uint32_t)tim) {
+#if defined(TIM1_CC_DMA_AVAILABLE)
+    case (uint32_t)TIM1_BASE:
+      map = TIM1_CC_DMA;
+      break;
+#endif
+#if defined(TIM2_CC_DMA_AVAILABLE)
+    case (uint32_t)TIM2_BASE:
+      map = TIM2_CC_DMA;
+      break;
+#endif
+#if defined(TIM3_CC_DMA_AVAILABLE)
+    case (uint32_t)TIM3_BASE:
+      map = TIM3_CC_DMA;
+      break;
+#endif
+#if defined(TIM4_CC_DMA_AVAILABLE)
+    case (uint32_t)TIM4_BASE:
+      map = TIM4_CC_DMA;
+      break;
+#endif
+#if defined(TIM5_CC_DMA_AVAILABLE)
+    case (uint32_t)TIM5_BASE:
+      map = TIM5_CC_DMA;
+      break;
+#endif
+#if defined(TIM8_CC_DMA_AVAILABLE)
+    case (uint32_t)TIM8_BASE:
+      map = TIM8_CC_DMA;
+      break;
+#endif
+#if defined(TIM15_CC_DMA_AVAILABLE)
+    case (uint32_t)TIM15_BASE:
+      map = TIM15_CC_DMA;
+      break;
+#endif
+#if defined(TIM16_CC_DMA_AVAILABLE)
+    case (uint32_t)TIM16_BASE:
+      map = TIM16_CC_DMA;
+      break;
+#endif
+#if defined(TIM17_CC_DMA_AVAILABLE)
+    case (uint32_t)TIM17_BASE:
+      map = TIM17_CC_DMA;
+      break;
+#endif
+    default:
+      break;
+  }
+  if ((map == NULL) || (map[channel - 1].instance == 0)) {
+    return false;
+  }
+#if defined(DMA1_Stream0)
+  hdma->Instance = (DMA_Stream_TypeDef *)map[channel - 1].instance;
+  hdma->Init.Channel = map[channel - 1].request;
+#else
+  hdma->Instance = (DMA_Channel_TypeDef *)map[channel - 1].instance;
+#if defined(STM32L0xx) || defined(STM32L4xx)
+  hdma->Init.Request = map[channel - 1].request;
+#endif
+#endif
+#endif /* DMAMUX1 */
+
+  enableTimerDmaClock();
+  return true;
+}
+
 #endif /* HAL_TIM_MODULE_ENABLED && !HAL_TIM_MODULE_ONLY */
 
 #ifdef __cplusplus
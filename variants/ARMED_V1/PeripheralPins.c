@@ -391,4 +391,43 @@ WEAK const PinMap PinMap_USB_OTG_HS[] = {
 #endif /* USE_USB_HS_IN_FS */
   {NC,    NP,    0}
 };
-#endif
\ No newline at end of file
+#endif
+
+/* ===== PinMap index, generated by CI/utils/gen_pinmap_index.py ===== */
+WEAK const PinMapIndex PinMap_Index[] = {
+#ifdef HAL_ADC_MODULE_ENABLED
+  {PinMap_ADC, {[PortC] = 0}, {[PortC] = 3}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SDA, {[PortB] = 0}, {[PortB] = 1}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SCL, {[PortB] = 0}, {[PortB] = 1}},
+#endif
+#ifdef HAL_TIM_MODULE_ENABLED
+  {PinMap_PWM, {[PortA] = 0, [PortB] = 3, [PortC] = 6}, {[PortA] = 3, [PortB] = 3, [PortC] = 4}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_TX, {[PortC] = 0, [PortD] = 1}, {[PortC] = 1, [PortD] = 1}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_RX, {[PortC] = 0, [PortD] = 1}, {[PortC] = 1, [PortD] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MOSI, {[PortA] = 0}, {[PortA] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MISO, {[PortA] = 0}, {[PortA] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SCLK, {[PortA] = 0}, {[PortA] = 1}},
+#endif
+#ifdef HAL_ETH_MODULE_ENABLED
+  {PinMap_Ethernet, {[PortA] = 0, [PortB] = 5, [PortC] = 13, [PortE] = 18}, {[PortA] = 5, [PortB] = 8, [PortC] = 5, [PortE] = 1}},
+#endif
+#ifdef HAL_PCD_MODULE_ENABLED
+  {PinMap_USB_OTG_FS, {[PortA] = 0}, {[PortA] = 5}},
+#endif
+  {NULL, {0}, {0}}
+};
+/* ===== End of PinMap index ===== */
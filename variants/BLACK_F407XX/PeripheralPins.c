@@ -456,3 +456,36 @@ WEAK const PinMap PinMap_SD[] = {
   {NC,    NP,    0}
 };
 #endif
+
+/* ===== PinMap index, generated by CI/utils/gen_pinmap_index.py ===== */
+WEAK const PinMapIndex PinMap_Index[] = {
+#ifdef HAL_DAC_MODULE_ENABLED
+  {PinMap_DAC, {[PortA] = 0}, {[PortA] = 2}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MOSI, {[PortA] = 0, [PortB] = 1, [PortC] = 3}, {[PortA] = 1, [PortB] = 2, [PortC] = 2}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MISO, {[PortA] = 0, [PortB] = 1, [PortC] = 3}, {[PortA] = 1, [PortB] = 2, [PortC] = 2}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SCLK, {[PortA] = 0, [PortB] = 1, [PortC] = 4}, {[PortA] = 1, [PortB] = 3, [PortC] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SSEL, {[PortA] = 0, [PortB] = 2}, {[PortA] = 2, [PortB] = 2}},
+#endif
+#ifdef HAL_CAN_MODULE_ENABLED
+  {PinMap_CAN_RD, {[PortA] = 0, [PortB] = 1, [PortD] = 4}, {[PortA] = 1, [PortB] = 3, [PortD] = 1}},
+#endif
+#ifdef HAL_CAN_MODULE_ENABLED
+  {PinMap_CAN_TD, {[PortA] = 0, [PortB] = 1, [PortD] = 4}, {[PortA] = 1, [PortB] = 3, [PortD] = 1}},
+#endif
+#ifdef HAL_PCD_MODULE_ENABLED
+  {PinMap_USB_OTG_FS, {[PortA] = 0}, {[PortA] = 2}},
+#endif
+#ifdef HAL_SD_MODULE_ENABLED
+  {PinMap_SD, {[PortC] = 0, [PortD] = 5}, {[PortC] = 5, [PortD] = 1}},
+#endif
+  {NULL, {0}, {0}}
+};
+/* ===== End of PinMap index ===== */
@@ -162,3 +162,45 @@ WEAK const PinMap PinMap_SPI_SSEL[] = {
 //*** No QUADSPI ***
 
 //*** No USB ***
+
+/* ===== PinMap index, generated by CI/utils/gen_pinmap_index.py ===== */
+WEAK const PinMapIndex PinMap_Index[] = {
+#ifdef HAL_ADC_MODULE_ENABLED
+  {PinMap_ADC, {[PortA] = 0, [PortB] = 8}, {[PortA] = 8, [PortB] = 1}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SDA, {[PortA] = 0}, {[PortA] = 1}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SCL, {[PortA] = 0}, {[PortA] = 1}},
+#endif
+#ifdef HAL_TIM_MODULE_ENABLED
+  {PinMap_PWM, {[PortA] = 0, [PortB] = 5}, {[PortA] = 5, [PortB] = 1}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_TX, {[PortA] = 0}, {[PortA] = 3}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_RX, {[PortA] = 0}, {[PortA] = 2}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_RTS, {[PortA] = 0}, {[PortA] = 1}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_CTS, {[PortA] = 0}, {[PortA] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MOSI, {[PortA] = 0}, {[PortA] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MISO, {[PortA] = 0}, {[PortA] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SCLK, {[PortA] = 0}, {[PortA] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SSEL, {[PortA] = 0}, {[PortA] = 1}},
+#endif
+  {NULL, {0}, {0}}
+};
+/* ===== End of PinMap index ===== */
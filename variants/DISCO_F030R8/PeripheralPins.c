@@ -210,3 +210,45 @@ WEAK const PinMap PinMap_SPI_SSEL[] = {
 //*** No QUADSPI ***
 
 //*** No USB ***
+
+/* ===== PinMap index, generated by CI/utils/gen_pinmap_index.py ===== */
+WEAK const PinMapIndex PinMap_Index[] = {
+#ifdef HAL_ADC_MODULE_ENABLED
+  {PinMap_ADC, {[PortA] = 0, [PortB] = 8, [PortC] = 10}, {[PortA] = 8, [PortB] = 2, [PortC] = 6}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SDA, {[PortB] = 0, [PortF] = 3}, {[PortB] = 3, [PortF] = 1}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SCL, {[PortB] = 0, [PortF] = 3}, {[PortB] = 3, [PortF] = 1}},
+#endif
+#ifdef HAL_TIM_MODULE_ENABLED
+  {PinMap_PWM, {[PortA] = 0, [PortB] = 9, [PortC] = 20}, {[PortA] = 9, [PortB] = 11, [PortC] = 4}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_TX, {[PortA] = 0, [PortB] = 3}, {[PortA] = 3, [PortB] = 1}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_RX, {[PortA] = 0, [PortB] = 3}, {[PortA] = 3, [PortB] = 1}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_RTS, {[PortA] = 0}, {[PortA] = 2}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_CTS, {[PortA] = 0}, {[PortA] = 2}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MOSI, {[PortA] = 0, [PortB] = 1}, {[PortA] = 1, [PortB] = 2}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MISO, {[PortA] = 0, [PortB] = 1}, {[PortA] = 1, [PortB] = 2}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SCLK, {[PortA] = 0, [PortB] = 1}, {[PortA] = 1, [PortB] = 2}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SSEL, {[PortA] = 0, [PortB] = 2}, {[PortA] = 2, [PortB] = 1}},
+#endif
+  {NULL, {0}, {0}}
+};
+/* ===== End of PinMap index ===== */
@@ -310,3 +310,27 @@ WEAK const PinMap PinMap_USB[] = {
 //*** No USB_OTG_FS ***
 
 //*** No USB_OTG_HS ***
+
+/* ===== PinMap index, generated by CI/utils/gen_pinmap_index.py ===== */
+WEAK const PinMapIndex PinMap_Index[] = {
+#ifdef HAL_DAC_MODULE_ENABLED
+  {PinMap_DAC, {[PortA] = 0}, {[PortA] = 2}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SDA, {[PortB] = 0}, {[PortB] = 4}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SCL, {[PortB] = 0}, {[PortB] = 4}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SCLK, {[PortA] = 0, [PortB] = 1}, {[PortA] = 1, [PortB] = 3}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SSEL, {[PortA] = 0, [PortB] = 2}, {[PortA] = 2, [PortB] = 2}},
+#endif
+#ifdef HAL_PCD_MODULE_ENABLED
+  {PinMap_USB, {[PortA] = 0}, {[PortA] = 2}},
+#endif
+  {NULL, {0}, {0}}
+};
+/* ===== End of PinMap index ===== */
@@ -524,4 +524,67 @@ WEAK const PinMap PinMap_SD[] = {
   {PD_2,  SDMMC1, STM_PIN_DATA(STM_MODE_AF_PP, GPIO_NOPULL, GPIO_AF12_SDMMC1)}, // SDMMC1_CMD
   {NC,    NP,    0}
 };
-#endif
\ No newline at end of file
+#endif
+
+/* ===== PinMap index, generated by CI/utils/gen_pinmap_index.py ===== */
+WEAK const PinMapIndex PinMap_Index[] = {
+#ifdef HAL_ADC_MODULE_ENABLED
+  {PinMap_ADC, {[PortA] = 0, [PortF] = 1}, {[PortA] = 1, [PortF] = 5}},
+#endif
+#ifdef HAL_DAC_MODULE_ENABLED
+  {PinMap_DAC, {[PortA] = 0}, {[PortA] = 2}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SDA, {[PortB] = 0}, {[PortB] = 1}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SCL, {[PortB] = 0}, {[PortB] = 1}},
+#endif
+#ifdef HAL_TIM_MODULE_ENABLED
+  {PinMap_PWM, {[PortA] = 0, [PortB] = 3, [PortC] = 8, [PortF] = 10, [PortH] = 14, [PortI] = 15}, {[PortA] = 3, [PortB] = 5, [PortC] = 2, [PortF] = 4, [PortH] = 1, [PortI] = 1}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_TX, {[PortA] = 0, [PortC] = 2, [PortF] = 3}, {[PortA] = 2, [PortC] = 1, [PortF] = 1}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_RX, {[PortB] = 0, [PortC] = 1, [PortF] = 2}, {[PortB] = 1, [PortC] = 1, [PortF] = 1}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_RTS, {[PortF] = 0}, {[PortF] = 1}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_CTS, {[PortF] = 0}, {[PortF] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MOSI, {[PortB] = 0, [PortF] = 1, [PortI] = 2}, {[PortB] = 1, [PortF] = 1, [PortI] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MISO, {[PortB] = 0, [PortF] = 1, [PortI] = 2}, {[PortB] = 1, [PortF] = 1, [PortI] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SCLK, {[PortF] = 0, [PortH] = 1, [PortI] = 2}, {[PortF] = 1, [PortH] = 1, [PortI] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SSEL, {[PortB] = 0, [PortF] = 2, [PortI] = 3}, {[PortB] = 2, [PortF] = 1, [PortI] = 1}},
+#endif
+#ifdef HAL_CAN_MODULE_ENABLED
+  {PinMap_CAN_RD, {[PortB] = 0}, {[PortB] = 1}},
+#endif
+#ifdef HAL_CAN_MODULE_ENABLED
+  {PinMap_CAN_TD, {[PortB] = 0}, {[PortB] = 1}},
+#endif
+#ifdef HAL_ETH_MODULE_ENABLED
+  {PinMap_Ethernet, {[PortA] = 0, [PortC] = 3, [PortG] = 6}, {[PortA] = 3, [PortC] = 3, [PortG] = 3}},
+#endif
+#ifdef HAL_QSPI_MODULE_ENABLED
+  {PinMap_QUADSPI, {[PortA] = 0, [PortB] = 1, [PortC] = 3, [PortD] = 6, [PortE] = 9, [PortF] = 14, [PortG] = 18, [PortH] = 20}, {[PortA] = 1, [PortB] = 2, [PortC] = 3, [PortD] = 3, [PortE] = 5, [PortF] = 4, [PortG] = 2, [PortH] = 2}},
+#endif
+#ifdef HAL_PCD_MODULE_ENABLED
+  {PinMap_USB_OTG_FS, {[PortA] = 0}, {[PortA] = 5}},
+#endif
+#ifdef HAL_SD_MODULE_ENABLED
+  {PinMap_SD, {[PortC] = 0, [PortD] = 5}, {[PortC] = 5, [PortD] = 1}},
+#endif
+  {NULL, {0}, {0}}
+};
+/* ===== End of PinMap index ===== */
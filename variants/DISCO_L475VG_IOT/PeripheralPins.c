@@ -388,3 +388,60 @@ WEAK const PinMap PinMap_USB_OTG_FS[] = {
 #endif
 
 //*** No USB_OTG_HS ***
+
+/* ===== PinMap index, generated by CI/utils/gen_pinmap_index.py ===== */
+WEAK const PinMapIndex PinMap_Index[] = {
+#ifdef HAL_ADC_MODULE_ENABLED
+  {PinMap_ADC, {[PortA] = 0, [PortB] = 8, [PortC] = 10}, {[PortA] = 8, [PortB] = 2, [PortC] = 6}},
+#endif
+#ifdef HAL_DAC_MODULE_ENABLED
+  {PinMap_DAC, {[PortA] = 0}, {[PortA] = 2}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SDA, {[PortB] = 0, [PortC] = 2}, {[PortB] = 2, [PortC] = 1}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SCL, {[PortB] = 0, [PortC] = 2}, {[PortB] = 2, [PortC] = 1}},
+#endif
+#ifdef HAL_TIM_MODULE_ENABLED
+  {PinMap_PWM, {[PortA] = 0, [PortB] = 8, [PortD] = 14}, {[PortA] = 8, [PortB] = 6, [PortD] = 1}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_TX, {[PortA] = 0, [PortB] = 2, [PortC] = 3, [PortD] = 4}, {[PortA] = 2, [PortB] = 1, [PortC] = 1, [PortD] = 2}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_RX, {[PortA] = 0, [PortB] = 2, [PortC] = 3, [PortD] = 4}, {[PortA] = 2, [PortB] = 1, [PortC] = 1, [PortD] = 2}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_RTS, {[PortD] = 0}, {[PortD] = 2}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_CTS, {[PortD] = 0}, {[PortD] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MOSI, {[PortA] = 0, [PortC] = 1, [PortD] = 2, [PortE] = 3}, {[PortA] = 1, [PortC] = 1, [PortD] = 1, [PortE] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MISO, {[PortA] = 0, [PortC] = 1, [PortD] = 2, [PortE] = 3}, {[PortA] = 1, [PortC] = 1, [PortD] = 1, [PortE] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SCLK, {[PortA] = 0, [PortC] = 1, [PortD] = 2, [PortE] = 3}, {[PortA] = 1, [PortC] = 1, [PortD] = 1, [PortE] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SSEL, {[PortA] = 0, [PortD] = 1, [PortE] = 2}, {[PortA] = 1, [PortD] = 1, [PortE] = 1}},
+#endif
+#ifdef HAL_CAN_MODULE_ENABLED
+  {PinMap_CAN_RD, {[PortB] = 0, [PortD] = 1}, {[PortB] = 1, [PortD] = 1}},
+#endif
+#ifdef HAL_CAN_MODULE_ENABLED
+  {PinMap_CAN_TD, {[PortB] = 0, [PortD] = 1}, {[PortB] = 1, [PortD] = 1}},
+#endif
+#ifdef HAL_QSPI_MODULE_ENABLED
+  {PinMap_QUADSPI, {[PortE] = 0}, {[PortE] = 6}},
+#endif
+#ifdef HAL_PCD_MODULE_ENABLED
+  {PinMap_USB_OTG_FS, {[PortA] = 0}, {[PortA] = 4}},
+#endif
+  {NULL, {0}, {0}}
+};
+/* ===== End of PinMap index ===== */
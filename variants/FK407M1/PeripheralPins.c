@@ -392,3 +392,60 @@ WEAK const PinMap PinMap_USB_OTG_HS[] = {
   {NC,    NP,    0}
 };
 #endif
+
+/* ===== PinMap index, generated by CI/utils/gen_pinmap_index.py ===== */
+WEAK const PinMapIndex PinMap_Index[] = {
+#ifdef HAL_ADC_MODULE_ENABLED
+  {PinMap_ADC, {[PortA] = 0, [PortB] = 8, [PortC] = 10}, {[PortA] = 8, [PortB] = 2, [PortC] = 6}},
+#endif
+#ifdef HAL_DAC_MODULE_ENABLED
+  {PinMap_DAC, {[PortA] = 0}, {[PortA] = 2}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SDA, {[PortB] = 0, [PortC] = 3}, {[PortB] = 3, [PortC] = 1}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SCL, {[PortA] = 0, [PortB] = 1}, {[PortA] = 1, [PortB] = 3}},
+#endif
+#ifdef HAL_TIM_MODULE_ENABLED
+  {PinMap_PWM, {[PortA] = 0, [PortB] = 11, [PortC] = 30, [PortD] = 38, [PortE] = 42}, {[PortA] = 11, [PortB] = 19, [PortC] = 8, [PortD] = 4, [PortE] = 9}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_TX, {[PortA] = 0, [PortB] = 3, [PortC] = 5, [PortD] = 8}, {[PortA] = 3, [PortB] = 2, [PortC] = 3, [PortD] = 2}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_RX, {[PortA] = 0, [PortB] = 3, [PortC] = 5, [PortD] = 7}, {[PortA] = 3, [PortB] = 2, [PortC] = 2, [PortD] = 3}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_RTS, {[PortA] = 0, [PortB] = 2, [PortD] = 3}, {[PortA] = 2, [PortB] = 1, [PortD] = 2}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_CTS, {[PortA] = 0, [PortB] = 2, [PortD] = 3}, {[PortA] = 2, [PortB] = 1, [PortD] = 2}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MOSI, {[PortA] = 0, [PortB] = 1, [PortC] = 4}, {[PortA] = 1, [PortB] = 3, [PortC] = 2}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MISO, {[PortA] = 0, [PortB] = 1, [PortC] = 4}, {[PortA] = 1, [PortB] = 3, [PortC] = 2}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SCLK, {[PortA] = 0, [PortB] = 1, [PortC] = 5}, {[PortA] = 1, [PortB] = 4, [PortC] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SSEL, {[PortA] = 0, [PortB] = 4}, {[PortA] = 4, [PortB] = 2}},
+#endif
+#ifdef HAL_CAN_MODULE_ENABLED
+  {PinMap_CAN_RD, {[PortA] = 0, [PortB] = 1, [PortD] = 4}, {[PortA] = 1, [PortB] = 3, [PortD] = 1}},
+#endif
+#ifdef HAL_CAN_MODULE_ENABLED
+  {PinMap_CAN_TD, {[PortA] = 0, [PortB] = 1, [PortD] = 4}, {[PortA] = 1, [PortB] = 3, [PortD] = 1}},
+#endif
+#ifdef HAL_ETH_MODULE_ENABLED
+  {PinMap_Ethernet, {[PortA] = 0, [PortB] = 5, [PortC] = 13, [PortE] = 18}, {[PortA] = 5, [PortB] = 8, [PortC] = 5, [PortE] = 1}},
+#endif
+#ifdef HAL_PCD_MODULE_ENABLED
+  {PinMap_USB_OTG_FS, {[PortA] = 0}, {[PortA] = 2}},
+#endif
+  {NULL, {0}, {0}}
+};
+/* ===== End of PinMap index ===== */
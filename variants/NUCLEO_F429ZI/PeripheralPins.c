@@ -443,3 +443,60 @@ WEAK const PinMap PinMap_USB_OTG_HS[] = {
   {NC,    NP,    0}
 };
 #endif
+
+/* ===== PinMap index, generated by CI/utils/gen_pinmap_index.py ===== */
+WEAK const PinMapIndex PinMap_Index[] = {
+#ifdef HAL_ADC_MODULE_ENABLED
+  {PinMap_ADC, {[PortA] = 0, [PortB] = 6, [PortC] = 7, [PortF] = 10}, {[PortA] = 6, [PortB] = 1, [PortC] = 3, [PortF] = 8}},
+#endif
+#ifdef HAL_DAC_MODULE_ENABLED
+  {PinMap_DAC, {[PortA] = 0}, {[PortA] = 2}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SDA, {[PortB] = 0, [PortC] = 2, [PortF] = 3}, {[PortB] = 2, [PortC] = 1, [PortF] = 1}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SCL, {[PortA] = 0, [PortB] = 1, [PortF] = 4}, {[PortA] = 1, [PortB] = 3, [PortF] = 1}},
+#endif
+#ifdef HAL_TIM_MODULE_ENABLED
+  {PinMap_PWM, {[PortA] = 0, [PortB] = 7, [PortC] = 17, [PortD] = 21, [PortE] = 25, [PortF] = 34}, {[PortA] = 7, [PortB] = 10, [PortC] = 4, [PortD] = 4, [PortE] = 9, [PortF] = 4}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_TX, {[PortA] = 0, [PortB] = 1, [PortC] = 3, [PortD] = 6, [PortE] = 8, [PortF] = 10, [PortG] = 11}, {[PortA] = 1, [PortB] = 2, [PortC] = 3, [PortD] = 2, [PortE] = 2, [PortF] = 1, [PortG] = 1}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_RX, {[PortA] = 0, [PortB] = 1, [PortC] = 2, [PortD] = 4, [PortE] = 7, [PortF] = 9, [PortG] = 10}, {[PortA] = 1, [PortB] = 1, [PortC] = 2, [PortD] = 3, [PortE] = 2, [PortF] = 1, [PortG] = 1}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_RTS, {[PortD] = 0, [PortG] = 2}, {[PortD] = 2, [PortG] = 2}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_CTS, {[PortA] = 0, [PortB] = 1, [PortD] = 2, [PortG] = 4}, {[PortA] = 1, [PortB] = 1, [PortD] = 2, [PortG] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MOSI, {[PortA] = 0, [PortB] = 1, [PortC] = 3, [PortD] = 5, [PortE] = 6, [PortF] = 8, [PortG] = 10}, {[PortA] = 1, [PortB] = 2, [PortC] = 2, [PortD] = 1, [PortE] = 2, [PortF] = 2, [PortG] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MISO, {[PortA] = 0, [PortB] = 1, [PortC] = 2, [PortE] = 4, [PortF] = 6, [PortG] = 7}, {[PortA] = 1, [PortB] = 1, [PortC] = 2, [PortE] = 2, [PortF] = 1, [PortG] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SCLK, {[PortA] = 0, [PortB] = 1, [PortC] = 4, [PortD] = 5, [PortE] = 6, [PortF] = 8}, {[PortA] = 1, [PortB] = 3, [PortC] = 1, [PortD] = 1, [PortE] = 2, [PortF] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SSEL, {[PortA] = 0, [PortB] = 2, [PortE] = 4, [PortF] = 6, [PortG] = 7}, {[PortA] = 2, [PortB] = 2, [PortE] = 2, [PortF] = 1, [PortG] = 1}},
+#endif
+#ifdef HAL_CAN_MODULE_ENABLED
+  {PinMap_CAN_RD, {[PortB] = 0, [PortD] = 3}, {[PortB] = 3, [PortD] = 1}},
+#endif
+#ifdef HAL_CAN_MODULE_ENABLED
+  {PinMap_CAN_TD, {[PortB] = 0, [PortD] = 3}, {[PortB] = 3, [PortD] = 1}},
+#endif
+#ifdef HAL_ETH_MODULE_ENABLED
+  {PinMap_Ethernet, {[PortA] = 0, [PortB] = 3, [PortC] = 4, [PortG] = 7}, {[PortA] = 3, [PortB] = 1, [PortC] = 3, [PortG] = 2}},
+#endif
+#ifdef HAL_PCD_MODULE_ENABLED
+  {PinMap_USB_OTG_FS, {[PortA] = 0}, {[PortA] = 5}},
+#endif
+  {NULL, {0}, {0}}
+};
+/* ===== End of PinMap index ===== */
@@ -530,3 +530,63 @@ WEAK const PinMap PinMap_USB_OTG_HS[] = {
   {NC,    NP,    0}
 };
 #endif
+
+/* ===== PinMap index, generated by CI/utils/gen_pinmap_index.py ===== */
+WEAK const PinMapIndex PinMap_Index[] = {
+#ifdef HAL_ADC_MODULE_ENABLED
+  {PinMap_ADC, {[PortA] = 0, [PortB] = 6, [PortC] = 7, [PortF] = 10}, {[PortA] = 6, [PortB] = 1, [PortC] = 3, [PortF] = 8}},
+#endif
+#ifdef HAL_DAC_MODULE_ENABLED
+  {PinMap_DAC, {[PortA] = 0}, {[PortA] = 2}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SDA, {[PortB] = 0, [PortC] = 2, [PortD] = 3, [PortF] = 4}, {[PortB] = 2, [PortC] = 1, [PortD] = 1, [PortF] = 2}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SCL, {[PortB] = 0, [PortD] = 3, [PortF] = 4}, {[PortB] = 3, [PortD] = 1, [PortF] = 2}},
+#endif
+#ifdef HAL_TIM_MODULE_ENABLED
+  {PinMap_PWM, {[PortA] = 0, [PortB] = 6, [PortC] = 18, [PortD] = 22, [PortE] = 23, [PortF] = 32}, {[PortA] = 6, [PortB] = 12, [PortC] = 4, [PortD] = 1, [PortE] = 9, [PortF] = 3}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_TX, {[PortA] = 0, [PortB] = 2, [PortC] = 6, [PortD] = 9, [PortE] = 12, [PortF] = 13, [PortG] = 14}, {[PortA] = 2, [PortB] = 4, [PortC] = 3, [PortD] = 3, [PortE] = 1, [PortF] = 1, [PortG] = 1}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_RX, {[PortA] = 0, [PortB] = 1, [PortC] = 6, [PortD] = 8, [PortE] = 12, [PortG] = 14}, {[PortA] = 1, [PortB] = 5, [PortC] = 2, [PortD] = 4, [PortE] = 2, [PortG] = 1}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_RTS, {[PortA] = 0, [PortC] = 1, [PortD] = 2, [PortE] = 4, [PortF] = 5}, {[PortA] = 1, [PortC] = 1, [PortD] = 2, [PortE] = 1, [PortF] = 1}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_CTS, {[PortA] = 0, [PortB] = 1, [PortC] = 3, [PortD] = 4, [PortE] = 6, [PortF] = 7}, {[PortA] = 1, [PortB] = 2, [PortC] = 1, [PortD] = 2, [PortE] = 1, [PortF] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MOSI, {[PortA] = 0, [PortB] = 1, [PortC] = 4, [PortD] = 6, [PortE] = 8, [PortF] = 10, [PortG] = 11}, {[PortA] = 1, [PortB] = 3, [PortC] = 2, [PortD] = 2, [PortE] = 2, [PortF] = 1, [PortG] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MISO, {[PortA] = 0, [PortB] = 1, [PortC] = 2, [PortE] = 4, [PortF] = 6, [PortG] = 7}, {[PortA] = 1, [PortB] = 1, [PortC] = 2, [PortE] = 2, [PortF] = 1, [PortG] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SCLK, {[PortA] = 0, [PortB] = 1, [PortC] = 4, [PortD] = 5, [PortE] = 6, [PortF] = 8}, {[PortA] = 1, [PortB] = 3, [PortC] = 1, [PortD] = 1, [PortE] = 2, [PortF] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SSEL, {[PortA] = 0, [PortB] = 4, [PortE] = 7}, {[PortA] = 4, [PortB] = 3, [PortE] = 2}},
+#endif
+#ifdef HAL_CAN_MODULE_ENABLED
+  {PinMap_CAN_RD, {[PortB] = 0, [PortD] = 4}, {[PortB] = 4, [PortD] = 1}},
+#endif
+#ifdef HAL_CAN_MODULE_ENABLED
+  {PinMap_CAN_TD, {[PortA] = 0, [PortB] = 1, [PortD] = 5}, {[PortA] = 1, [PortB] = 4, [PortD] = 1}},
+#endif
+#ifdef HAL_ETH_MODULE_ENABLED
+  {PinMap_Ethernet, {[PortA] = 0, [PortB] = 3, [PortC] = 4, [PortG] = 7}, {[PortA] = 3, [PortB] = 1, [PortC] = 3, [PortG] = 2}},
+#endif
+#ifdef HAL_QSPI_MODULE_ENABLED
+  {PinMap_QUADSPI, {[PortB] = 0, [PortC] = 3, [PortD] = 6, [PortE] = 9, [PortF] = 14, [PortG] = 18}, {[PortB] = 3, [PortC] = 3, [PortD] = 3, [PortE] = 5, [PortF] = 4, [PortG] = 2}},
+#endif
+#ifdef HAL_PCD_MODULE_ENABLED
+  {PinMap_USB_OTG_FS, {[PortA] = 0}, {[PortA] = 5}},
+#endif
+  {NULL, {0}, {0}}
+};
+/* ===== End of PinMap index ===== */
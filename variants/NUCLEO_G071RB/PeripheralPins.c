@@ -307,3 +307,48 @@ WEAK const PinMap PinMap_SPI_SSEL[] = {
 //*** No QUADSPI ***
 
 //*** No USB ***
+
+/* ===== PinMap index, generated by CI/utils/gen_pinmap_index.py ===== */
+WEAK const PinMapIndex PinMap_Index[] = {
+#ifdef HAL_ADC_MODULE_ENABLED
+  {PinMap_ADC, {[PortA] = 0, [PortB] = 5}, {[PortA] = 5, [PortB] = 5}},
+#endif
+#ifdef HAL_DAC_MODULE_ENABLED
+  {PinMap_DAC, {[PortA] = 0}, {[PortA] = 2}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SDA, {[PortA] = 0, [PortB] = 2}, {[PortA] = 2, [PortB] = 4}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SCL, {[PortA] = 0, [PortB] = 2}, {[PortA] = 2, [PortB] = 4}},
+#endif
+#ifdef HAL_TIM_MODULE_ENABLED
+  {PinMap_PWM, {[PortA] = 0, [PortB] = 11, [PortC] = 25, [PortD] = 36, [PortF] = 41}, {[PortA] = 11, [PortB] = 14, [PortC] = 11, [PortD] = 5, [PortF] = 2}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_TX, {[PortA] = 0, [PortB] = 5, [PortC] = 10, [PortD] = 13}, {[PortA] = 5, [PortB] = 5, [PortC] = 3, [PortD] = 2}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_RX, {[PortA] = 0, [PortB] = 4, [PortC] = 9, [PortD] = 12}, {[PortA] = 4, [PortB] = 5, [PortC] = 3, [PortD] = 2}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_RTS, {[PortA] = 0, [PortB] = 3, [PortD] = 8}, {[PortA] = 3, [PortB] = 5, [PortD] = 2}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_CTS, {[PortA] = 0, [PortB] = 4, [PortD] = 8}, {[PortA] = 4, [PortB] = 4, [PortD] = 1}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MOSI, {[PortA] = 0, [PortB] = 4, [PortC] = 8, [PortD] = 9}, {[PortA] = 4, [PortB] = 4, [PortC] = 1, [PortD] = 2}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MISO, {[PortA] = 0, [PortB] = 3, [PortC] = 7, [PortD] = 8}, {[PortA] = 3, [PortB] = 4, [PortC] = 1, [PortD] = 2}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SCLK, {[PortA] = 0, [PortB] = 3, [PortD] = 7}, {[PortA] = 3, [PortB] = 4, [PortD] = 2}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SSEL, {[PortA] = 0, [PortB] = 3, [PortD] = 6}, {[PortA] = 3, [PortB] = 3, [PortD] = 2}},
+#endif
+  {NULL, {0}, {0}}
+};
+/* ===== End of PinMap index ===== */
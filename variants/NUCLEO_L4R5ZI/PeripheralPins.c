@@ -434,3 +434,48 @@ WEAK const PinMap PinMap_SD[] = {
   {NC,    NP,    0}
 };
 #endif
+
+/* ===== PinMap index, generated by CI/utils/gen_pinmap_index.py ===== */
+WEAK const PinMapIndex PinMap_Index[] = {
+#ifdef HAL_ADC_MODULE_ENABLED
+  {PinMap_ADC, {[PortA] = 0, [PortB] = 8, [PortC] = 10}, {[PortA] = 8, [PortB] = 2, [PortC] = 6}},
+#endif
+#ifdef HAL_DAC_MODULE_ENABLED
+  {PinMap_DAC, {[PortA] = 0}, {[PortA] = 2}},
+#endif
+#ifdef HAL_I2C_MODULE_ENABLED
+  {PinMap_I2C_SCL, {[PortA] = 0, [PortB] = 1, [PortC] = 5, [PortD] = 6, [PortF] = 7, [PortG] = 9}, {[PortA] = 1, [PortB] = 4, [PortC] = 1, [PortD] = 1, [PortF] = 2, [PortG] = 2}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_RTS, {[PortA] = 0, [PortB] = 3, [PortD] = 8, [PortG] = 11}, {[PortA] = 3, [PortB] = 5, [PortD] = 3, [PortG] = 2}},
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+  {PinMap_UART_CTS, {[PortA] = 0, [PortB] = 3, [PortD] = 7, [PortG] = 9}, {[PortA] = 3, [PortB] = 4, [PortD] = 2, [PortG] = 2}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MOSI, {[PortA] = 0, [PortB] = 2, [PortC] = 4, [PortD] = 7, [PortE] = 9, [PortG] = 10}, {[PortA] = 2, [PortB] = 2, [PortC] = 3, [PortD] = 2, [PortE] = 1, [PortG] = 2}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_MISO, {[PortA] = 0, [PortB] = 2, [PortC] = 4, [PortD] = 6, [PortE] = 7, [PortG] = 8}, {[PortA] = 2, [PortB] = 2, [PortC] = 2, [PortD] = 1, [PortE] = 1, [PortG] = 2}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SCLK, {[PortA] = 0, [PortB] = 3, [PortC] = 6, [PortD] = 7, [PortE] = 9, [PortG] = 10}, {[PortA] = 3, [PortB] = 3, [PortC] = 1, [PortD] = 2, [PortE] = 1, [PortG] = 2}},
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+  {PinMap_SPI_SSEL, {[PortA] = 0, [PortB] = 2, [PortD] = 5, [PortE] = 6, [PortG] = 7}, {[PortA] = 2, [PortB] = 3, [PortD] = 1, [PortE] = 1, [PortG] = 2}},
+#endif
+#ifdef HAL_CAN_MODULE_ENABLED
+  {PinMap_CAN_RD, {[PortA] = 0, [PortB] = 1, [PortD] = 2}, {[PortA] = 1, [PortB] = 1, [PortD] = 1}},
+#endif
+#ifdef HAL_CAN_MODULE_ENABLED
+  {PinMap_CAN_TD, {[PortA] = 0, [PortB] = 1, [PortD] = 2}, {[PortA] = 1, [PortB] = 1, [PortD] = 1}},
+#endif
+#ifdef HAL_PCD_MODULE_ENABLED
+  {PinMap_USB_OTG_FS, {[PortA] = 0, [PortC] = 5}, {[PortA] = 5, [PortC] = 1}},
+#endif
+#ifdef HAL_SD_MODULE_ENABLED
+  {PinMap_SD, {[PortC] = 0, [PortD] = 5}, {[PortC] = 5, [PortD] = 1}},
+#endif
+  {NULL, {0}, {0}}
+};
+/* ===== End of PinMap index ===== */